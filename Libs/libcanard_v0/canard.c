@@ -726,6 +726,35 @@ void canardCleanupStaleTransfers(CanardInstance* ins, uint64_t current_time_usec
 #endif
 }
 
+void canardReleaseRxStates(CanardInstance* ins, uint16_t data_type_id, CanardTransferType transfer_type)
+{
+    const uint32_t descriptor = MAKE_TRANSFER_DESCRIPTOR(data_type_id, transfer_type, 0U, 0U);
+    CanardRxState* prev = NULL, * state = ins->rx_states;
+
+    while (state != NULL)
+    {
+        CanardRxState* next = canardRxFromIdx(&ins->allocator, state->next);
+        if ((state->dtid_tt_snid_dnid & 0x3FFFFU) == descriptor)
+        {
+            releaseStatePayload(ins, state);
+            if (prev == NULL)
+            {
+                ins->rx_states = next;
+            }
+            else
+            {
+                prev->next = state->next;
+            }
+            freeBlock(&ins->allocator, state);
+        }
+        else
+        {
+            prev = state;
+        }
+        state = next;
+    }
+}
+
 int16_t canardDecodeScalar(const CanardRxTransfer* transfer,
                            uint32_t bit_offset,
                            uint8_t bit_length,
@@ -625,6 +625,15 @@ int16_t canardHandleRxFrame(CanardInstance* ins,
 void canardCleanupStaleTransfers(CanardInstance* ins,
                                  uint64_t current_time_usec);
 
+/**
+ * Removes all RX states of the given data type ID and transfer type and releases their payload buffers.
+ * This function can be used when the application is no longer interested in the data type.
+ * It must not be called from the reception callback for the data type of the transfer being received.
+ */
+void canardReleaseRxStates(CanardInstance* ins,
+                           uint16_t data_type_id,
+                           CanardTransferType transfer_type);
+
 /**
  * This function can be used to extract values from received UAVCAN transfers. It decodes a scalar value -
  * boolean, integer, character, or floating point - from the specified bit position in the RX transfer buffer.
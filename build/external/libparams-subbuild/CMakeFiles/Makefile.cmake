@@ -0,0 +1,49 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by "Unix Makefiles" Generator, CMake Version 3.25
+
+# The generator used is:
+set(CMAKE_DEPENDS_GENERATOR "Unix Makefiles")
+
+# The top level Makefile was generated from the following files:
+set(CMAKE_MAKEFILE_DEPENDS
+  "CMakeCache.txt"
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "CMakeLists.txt"
+  "libparams-populate-prefix/tmp/libparams-populate-mkdirs.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeDetermineSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeGenericSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeInitializeConfigs.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystem.cmake.in"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInitialize.cmake"
+  "/usr/share/cmake-3.25/Modules/ExternalProject.cmake"
+  "/usr/share/cmake-3.25/Modules/ExternalProject/RepositoryInfo.txt.in"
+  "/usr/share/cmake-3.25/Modules/ExternalProject/cfgcmd.txt.in"
+  "/usr/share/cmake-3.25/Modules/ExternalProject/gitclone.cmake.in"
+  "/usr/share/cmake-3.25/Modules/ExternalProject/gitupdate.cmake.in"
+  "/usr/share/cmake-3.25/Modules/ExternalProject/mkdirs.cmake.in"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/UnixPaths.cmake"
+  )
+
+# The corresponding makefile is:
+set(CMAKE_MAKEFILE_OUTPUTS
+  "Makefile"
+  "CMakeFiles/cmake.check_cache"
+  )
+
+# Byproducts of CMake generate step:
+set(CMAKE_MAKEFILE_PRODUCTS
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "libparams-populate-prefix/tmp/libparams-populate-mkdirs.cmake"
+  "libparams-populate-prefix/tmp/libparams-populate-gitclone.cmake"
+  "libparams-populate-prefix/src/libparams-populate-stamp/libparams-populate-gitinfo.txt"
+  "libparams-populate-prefix/tmp/libparams-populate-gitupdate.cmake"
+  "libparams-populate-prefix/tmp/libparams-populate-cfgcmd.txt"
+  "CMakeFiles/CMakeDirectoryInformation.cmake"
+  )
+
+# Dependency information for all targets:
+set(CMAKE_DEPEND_INFO_FILES
+  "CMakeFiles/libparams-populate.dir/DependInfo.cmake"
+  )
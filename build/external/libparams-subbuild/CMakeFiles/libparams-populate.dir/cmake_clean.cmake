@@ -0,0 +1,17 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/libparams-populate"
+  "CMakeFiles/libparams-populate-complete"
+  "libparams-populate-prefix/src/libparams-populate-stamp/libparams-populate-build"
+  "libparams-populate-prefix/src/libparams-populate-stamp/libparams-populate-configure"
+  "libparams-populate-prefix/src/libparams-populate-stamp/libparams-populate-download"
+  "libparams-populate-prefix/src/libparams-populate-stamp/libparams-populate-install"
+  "libparams-populate-prefix/src/libparams-populate-stamp/libparams-populate-mkdir"
+  "libparams-populate-prefix/src/libparams-populate-stamp/libparams-populate-patch"
+  "libparams-populate-prefix/src/libparams-populate-stamp/libparams-populate-test"
+  "libparams-populate-prefix/src/libparams-populate-stamp/libparams-populate-update"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang )
+  include(CMakeFiles/libparams-populate.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,22 @@
+# Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+# file Copyright.txt or https://cmake.org/licensing for details.
+
+cmake_minimum_required(VERSION 3.5)
+
+file(MAKE_DIRECTORY
+  "/root/repo/build/external/libparams-src"
+  "/root/repo/build/external/libparams-build"
+  "/root/repo/build/external/libparams-subbuild/libparams-populate-prefix"
+  "/root/repo/build/external/libparams-subbuild/libparams-populate-prefix/tmp"
+  "/root/repo/build/external/libparams-subbuild/libparams-populate-prefix/src/libparams-populate-stamp"
+  "/root/repo/build/external/libparams-subbuild/libparams-populate-prefix/src"
+  "/root/repo/build/external/libparams-subbuild/libparams-populate-prefix/src/libparams-populate-stamp"
+)
+
+set(configSubDirs )
+foreach(subDir IN LISTS configSubDirs)
+    file(MAKE_DIRECTORY "/root/repo/build/external/libparams-subbuild/libparams-populate-prefix/src/libparams-populate-stamp/${subDir}")
+endforeach()
+if(cfgdir)
+  file(MAKE_DIRECTORY "/root/repo/build/external/libparams-subbuild/libparams-populate-prefix/src/libparams-populate-stamp${cfgdir}") # cfgdir has leading slash
+endif()
@@ -0,0 +1,21 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/Libs/libcanard_v0/canard.c" "CMakeFiles/libdcnode.dir/Libs/libcanard_v0/canard.c.o" "gcc" "CMakeFiles/libdcnode.dir/Libs/libcanard_v0/canard.c.o.d"
+  "/root/repo/src/dronecan.c" "CMakeFiles/libdcnode.dir/src/dronecan.c.o" "gcc" "CMakeFiles/libdcnode.dir/src/dronecan.c.o.d"
+  "/root/repo/src/logger.cpp" "CMakeFiles/libdcnode.dir/src/logger.cpp.o" "gcc" "CMakeFiles/libdcnode.dir/src/logger.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/libdcnode.dir/Libs/libcanard_v0/canard.c.o"
+  "CMakeFiles/libdcnode.dir/Libs/libcanard_v0/canard.c.o.d"
+  "CMakeFiles/libdcnode.dir/src/dronecan.c.o"
+  "CMakeFiles/libdcnode.dir/src/dronecan.c.o.d"
+  "CMakeFiles/libdcnode.dir/src/logger.cpp.o"
+  "CMakeFiles/libdcnode.dir/src/logger.cpp.o.d"
+  "liblibdcnode.a"
+  "liblibdcnode.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C CXX)
+  include(CMakeFiles/libdcnode.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_rx_states_release.dir/test_rx_states_release.cpp.o"
+  "CMakeFiles/test_rx_states_release.dir/test_rx_states_release.cpp.o.d"
+  "test_rx_states_release"
+  "test_rx_states_release.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_rx_states_release.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
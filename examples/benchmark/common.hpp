@@ -0,0 +1,39 @@
+/*
+ * Copyright (C) 2025 Dmitry Ponomarev <ponomarevda96@gmail.com>
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef EXAMPLES_BENCHMARK_COMMON_HPP_
+#define EXAMPLES_BENCHMARK_COMMON_HPP_
+
+#include <stdint.h>
+#include <chrono>
+#include <cstdio>
+
+/**
+ * @brief Run the function the given number of times and print the average time of one call
+ * @return the average time of one call in nanoseconds
+ */
+template <typename Function>
+double benchmarkRun(const char* name, uint32_t iterations, Function function) {
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t idx = 0; idx < iterations; idx++) {
+        function();
+    }
+    auto end = std::chrono::steady_clock::now();
+    double ns = std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+    printf("%-48s %10.1f ns\n", name, ns);
+    return ns;
+}
+
+/**
+ * @brief Keep the compiler from optimizing out a benchmarked computation
+ */
+template <typename T>
+inline void benchmarkDoNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+#endif  // EXAMPLES_BENCHMARK_COMMON_HPP_
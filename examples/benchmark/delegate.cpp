@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2025 Dmitry Ponomarev <ponomarevda96@gmail.com>
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+/**
+ * @brief Call overhead of a subscriber callback: raw function pointer, std::function and DronecanDelegate.
+ * The callable is reloaded from memory before each call, so the compiler can't inline it.
+ * The last rows construct the callable on each call: std::function allocates when the captures
+ * don't fit its small buffer, DronecanDelegate never does.
+ */
+#include <cstdio>
+#include <functional>
+#include "common.hpp"
+#include "libdcnode/delegate.hpp"
+#include "libdcnode/uavcan/equipment/esc/RawCommand.h"
+
+static constexpr uint32_t ITERATIONS = 20000000;
+
+static RawCommand_t msg{};
+static uint32_t counter = 0;
+
+__attribute__((noinline)) static void onRawCommand(const RawCommand_t& cmd) {
+    counter += static_cast<uint32_t>(cmd.raw_cmd[0]);
+}
+
+class Motor {
+public:
+    __attribute__((noinline)) void onRawCommand(const RawCommand_t& cmd) {
+        setpoint += static_cast<uint32_t>(cmd.raw_cmd[channel]);
+    }
+    uint8_t channel{0};
+    uint32_t setpoint{0};
+};
+
+template <typename Callable>
+static double benchmarkCall(const char* name, Callable& callable) {
+    return benchmarkRun(name, ITERATIONS, [&callable]() {
+        benchmarkDoNotOptimize(&callable);
+        callable(msg);
+    });
+}
+
+int main() {
+    msg.raw_cmd[0] = 1;
+    Motor motor;
+    uint32_t* counter_ptr = &counter;
+    uint8_t channel = 0;
+
+    void (*raw_pointer)(const RawCommand_t&) = onRawCommand;
+    std::function<void(const RawCommand_t&)> function_pointer = onRawCommand;
+    std::function<void(const RawCommand_t&)> function_lambda = [counter_ptr, channel](const RawCommand_t& cmd) {
+        *counter_ptr += static_cast<uint32_t>(cmd.raw_cmd[channel]);
+    };
+    std::function<void(const RawCommand_t&)> function_member = [&motor](const RawCommand_t& cmd) {
+        motor.onRawCommand(cmd);
+    };
+
+    using Callback = DronecanDelegate<void(const RawCommand_t&)>;
+    Callback delegate_pointer = onRawCommand;
+    Callback delegate_lambda = [counter_ptr, channel](const RawCommand_t& cmd) {
+        *counter_ptr += static_cast<uint32_t>(cmd.raw_cmd[channel]);
+    };
+    Callback delegate_member = Callback::bind<&Motor::onRawCommand>(&motor);
+
+    benchmarkCall("raw function pointer", raw_pointer);
+    benchmarkCall("std::function, function pointer", function_pointer);
+    benchmarkCall("std::function, lambda with captures", function_lambda);
+    benchmarkCall("std::function, member function", function_member);
+    benchmarkCall("DronecanDelegate, function pointer", delegate_pointer);
+    benchmarkCall("DronecanDelegate, lambda with captures", delegate_lambda);
+    benchmarkCall("DronecanDelegate, member function", delegate_member);
+
+    uint32_t* setpoint_ptr = &motor.setpoint;
+    benchmarkRun("std::function, construct with 3 captures", ITERATIONS, [&]() {
+        std::function<void(const RawCommand_t&)> function = [counter_ptr, setpoint_ptr, &motor](
+                const RawCommand_t& cmd) {
+            *counter_ptr += static_cast<uint32_t>(cmd.raw_cmd[motor.channel]);
+            *setpoint_ptr += 1;
+        };
+        benchmarkDoNotOptimize(&function);
+        function(msg);
+    });
+    benchmarkRun("DronecanDelegate<32>, construct with 3 captures", ITERATIONS, [&]() {
+        DronecanDelegate<void(const RawCommand_t&), 32> delegate = [counter_ptr, setpoint_ptr, &motor](
+                const RawCommand_t& cmd) {
+            *counter_ptr += static_cast<uint32_t>(cmd.raw_cmd[motor.channel]);
+            *setpoint_ptr += 1;
+        };
+        benchmarkDoNotOptimize(&delegate);
+        delegate(msg);
+    });
+
+    printf("%-48s %10zu bytes\n", "sizeof(raw function pointer)", sizeof(raw_pointer));
+    printf("%-48s %10zu bytes\n", "sizeof(std::function)", sizeof(function_pointer));
+    printf("%-48s %10zu bytes\n", "sizeof(DronecanDelegate)", sizeof(delegate_pointer));
+
+    benchmarkDoNotOptimize(counter + motor.setpoint);
+    return 0;
+}
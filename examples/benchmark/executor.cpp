@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2025 Dmitry Ponomarev <ponomarevda96@gmail.com>
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+/**
+ * @brief Four subscriptions with an expensive callback receive a burst of transfers through uavcanSpinOnce.
+ * Compare the inline callbacks with the executor for 1..N workers. A speedup needs a hardware thread
+ * per worker, with a single hardware thread the numbers show only the executor overhead.
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+#include "common.hpp"
+#include "libdcnode/executor.hpp"
+
+static constexpr uint32_t NUMBER_OF_TRANSFERS = 8000;
+static constexpr auto CALLBACK_DURATION = std::chrono::microseconds(20);
+static constexpr uint8_t SOURCE_NODE_ID = 42;
+
+static std::vector<CanardCANFrame> frames;
+static size_t next_frame_idx = 0;
+
+static int16_t canInit(uint32_t, uint8_t) {
+    return 0;
+}
+static int16_t canRecv(CanardCANFrame* const rx_frame, uint8_t) {
+    if (next_frame_idx >= frames.size()) {
+        return 0;
+    }
+    *rx_frame = frames[next_frame_idx++];
+    return 1;
+}
+static int16_t canSend(const CanardCANFrame* const, uint8_t) {
+    return 1;
+}
+static uint32_t getTimeMs() {
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(now).count());
+}
+static void readUniqueId(uint8_t out_uid[16]) {
+    for (uint8_t idx = 0; idx < 16; idx++) {
+        out_uid[idx] = idx;
+    }
+}
+
+/**
+ * @brief Emulate an expensive callback such as logging to disk or sensor fusion
+ */
+static void work() {
+    auto deadline = std::chrono::steady_clock::now() + CALLBACK_DURATION;
+    while (std::chrono::steady_clock::now() < deadline) {
+    }
+}
+template <typename MessageType>
+static void expensiveCallback(const MessageType& msg) {
+    benchmarkDoNotOptimize(msg);
+    work();
+}
+
+static void pushSingleFrameTransfer(uint16_t data_type_id, uint8_t payload_len, uint8_t transfer_id) {
+    CanardCANFrame frame{};
+    frame.id = CANARD_CAN_FRAME_EFF | (CANARD_TRANSFER_PRIORITY_MEDIUM << 24) |
+               (static_cast<uint32_t>(data_type_id) << 8) | SOURCE_NODE_ID;
+    for (uint8_t idx = 0; idx < payload_len; idx++) {
+        frame.data[idx] = static_cast<uint8_t>(transfer_id + idx);
+    }
+    frame.data[payload_len] = 0xC0 | (transfer_id & 0x1F);
+    frame.data_len = payload_len + 1;
+    frames.push_back(frame);
+}
+
+/**
+ * @brief Spin the node until the burst is received and all callbacks are finished
+ * @return the wall time per transfer in nanoseconds
+ */
+template <typename WaitIdle>
+static double receiveBurst(const char* name, WaitIdle wait_idle) {
+    next_frame_idx = 0;
+    auto start = std::chrono::steady_clock::now();
+    while (next_frame_idx < frames.size()) {
+        uavcanSpinOnce();
+    }
+    wait_idle();
+    auto end = std::chrono::steady_clock::now();
+    double ns = std::chrono::duration<double, std::nano>(end - start).count() / NUMBER_OF_TRANSFERS;
+    printf("%-48s %10.1f ns\n", name, ns);
+    return ns;
+}
+
+int main() {
+    PlatformApi platform_api{};
+    platform_api.getTimeMs = getTimeMs;
+    platform_api.readUniqueId = readUniqueId;
+    platform_api.can.init = canInit;
+    platform_api.can.recv = canRecv;
+    platform_api.can.send = canSend;
+    if (uavcanInitApplication(ParamsApi{}, platform_api, nullptr) < 0) {
+        return -1;
+    }
+
+    for (uint32_t idx = 0; idx < NUMBER_OF_TRANSFERS / 4; idx++) {
+        auto transfer_id = static_cast<uint8_t>(idx);
+        pushSingleFrameTransfer(UAVCAN_EQUIPMENT_INDICATION_BEEPCOMMAND_ID, 4, transfer_id);
+        pushSingleFrameTransfer(UAVCAN_EQUIPMENT_INDICATION_LIGHTS_COMMAND_ID, 3, transfer_id);
+        pushSingleFrameTransfer(UAVCAN_EQUIPMENT_SAFETY_ARMING_STATUS_ID, 1, transfer_id);
+        pushSingleFrameTransfer(UAVCAN_EQUIPMENT_HARDPOINT_COMMAND_ID, 3, transfer_id);
+    }
+
+    double inline_ns;
+    {
+        DronecanSubscriber<BeepCommand_t> beep_sub;
+        DronecanSubscriber<LightsCommand_t> lights_sub;
+        DronecanSubscriber<SafetyArmingStatus> arming_sub;
+        DronecanSubscriber<HardpointCommand> hardpoint_sub;
+        beep_sub.init(expensiveCallback<BeepCommand_t>);
+        lights_sub.init(expensiveCallback<LightsCommand_t>);
+        arming_sub.init(expensiveCallback<SafetyArmingStatus>);
+        hardpoint_sub.init(expensiveCallback<HardpointCommand>);
+        inline_ns = receiveBurst("inline callbacks", []() {});
+        beep_sub.unsubscribe();
+        lights_sub.unsubscribe();
+        arming_sub.unsubscribe();
+        hardpoint_sub.unsubscribe();
+    }
+
+    using Executor = DronecanExecutor<8, 64>;
+    const unsigned max_workers = std::max(4U, std::min(8U, std::thread::hardware_concurrency()));
+    for (uint8_t number_of_workers = 1; number_of_workers <= max_workers; number_of_workers *= 2) {
+        Executor executor;
+        executor.start(number_of_workers);
+
+        DronecanParallelSubscriber<BeepCommand_t, Executor> beep_sub;
+        DronecanParallelSubscriber<LightsCommand_t, Executor> lights_sub;
+        DronecanParallelSubscriber<SafetyArmingStatus, Executor> arming_sub;
+        DronecanParallelSubscriber<HardpointCommand, Executor> hardpoint_sub;
+        beep_sub.init(&executor, expensiveCallback<BeepCommand_t>);
+        lights_sub.init(&executor, expensiveCallback<LightsCommand_t>);
+        arming_sub.init(&executor, expensiveCallback<SafetyArmingStatus>);
+        hardpoint_sub.init(&executor, expensiveCallback<HardpointCommand>);
+
+        char name[64];
+        snprintf(name, sizeof(name), "executor, %u workers", number_of_workers);
+        double ns = receiveBurst(name, [&executor]() { executor.waitIdle(); });
+        printf("%-48s %10.1f x, blocked=%llu\n", "speedup", inline_ns / ns,
+               (unsigned long long)executor.getNumberOfBlocked());
+
+        beep_sub.unsubscribe();
+        lights_sub.unsubscribe();
+        arming_sub.unsubscribe();
+        hardpoint_sub.unsubscribe();
+    }
+
+    printf("%-48s %10u\n", "hardware threads", std::thread::hardware_concurrency());
+    return 0;
+}
@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2025 Dmitry Ponomarev <ponomarevda96@gmail.com>
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+/**
+ * @brief Several threads publish single-frame messages while another thread spins the node.
+ * Compare one mutex around every uavcanPublish and uavcanSpinOnce with the lock-free uavcanPublishAsync.
+ */
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "common.hpp"
+#include "libdcnode/dronecan.h"
+#include "libdcnode/uavcan/equipment/device/Temperature.h"
+
+static constexpr uint32_t MESSAGES_PER_THREAD = 20000;
+
+static std::atomic<uint64_t> number_of_sent_frames{0};
+
+static int16_t canInit(uint32_t, uint8_t) {
+    return 0;
+}
+static int16_t canRecv(CanardCANFrame* const, uint8_t) {
+    return 0;
+}
+static int16_t canSend(const CanardCANFrame* const, uint8_t) {
+    number_of_sent_frames.fetch_add(1, std::memory_order_relaxed);
+    return 1;
+}
+static uint32_t getTimeMs() {
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(now).count());
+}
+static void readUniqueId(uint8_t out_uid[16]) {
+    for (uint8_t idx = 0; idx < 16; idx++) {
+        out_uid[idx] = idx;
+    }
+}
+
+/**
+ * @brief Run the producers and the spin thread. Print the wall time per message, which is bounded
+ * by the spin thread, and the time a producer spends inside one publish call.
+ * @return the average time of one publish call in nanoseconds
+ */
+template <typename Publish, typename Spin>
+static double runContention(const char* name, uint8_t number_of_threads, Publish publish, Spin spin) {
+    std::atomic<uint8_t> number_of_running{number_of_threads};
+    std::atomic<uint64_t> number_of_retries{0};
+    std::atomic<uint64_t> publish_ns{0};
+    std::vector<std::thread> producers;
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint8_t thread_idx = 0; thread_idx < number_of_threads; thread_idx++) {
+        producers.emplace_back([&, thread_idx]() {
+            uint8_t transfer_id = 0;
+            uint8_t payload[5] = {thread_idx, 0, 0, 0, 0};
+            std::chrono::steady_clock::duration inside_publish{0};
+            for (uint32_t idx = 0; idx < MESSAGES_PER_THREAD; idx++) {
+                payload[1] = static_cast<uint8_t>(idx);
+                while (true) {
+                    auto call_start = std::chrono::steady_clock::now();
+                    auto res = publish(&transfer_id, payload, sizeof(payload));
+                    inside_publish += std::chrono::steady_clock::now() - call_start;
+                    if (res >= 0) {
+                        break;
+                    }
+                    number_of_retries.fetch_add(1, std::memory_order_relaxed);
+                    std::this_thread::yield();
+                }
+            }
+            publish_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(inside_publish).count();
+            number_of_running--;
+        });
+    }
+
+    while (number_of_running > 0) {
+        spin();
+        std::this_thread::yield();
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    for (uint8_t idx = 0; idx < 4; idx++) {
+        spin();
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    uint64_t number_of_messages = static_cast<uint64_t>(number_of_threads) * MESSAGES_PER_THREAD;
+    double wall_ns = std::chrono::duration<double, std::nano>(end - start).count() / number_of_messages;
+    double call_ns = static_cast<double>(publish_ns.load()) / number_of_messages;
+    printf("%-48s %10.1f ns/msg, %8.1f ns/call, retries=%llu\n",
+           name, wall_ns, call_ns, (unsigned long long)number_of_retries.load());
+    return call_ns;
+}
+
+int main() {
+    PlatformApi platform_api{};
+    platform_api.getTimeMs = getTimeMs;
+    platform_api.readUniqueId = readUniqueId;
+    platform_api.can.init = canInit;
+    platform_api.can.recv = canRecv;
+    platform_api.can.send = canSend;
+    if (uavcanInitApplication(ParamsApi{}, platform_api, nullptr) < 0) {
+        return -1;
+    }
+
+    std::mutex mutex;
+    auto locked_publish = [&](uint8_t* transfer_id, const uint8_t* payload, uint16_t len) {
+        std::lock_guard<std::mutex> lock(mutex);
+        return uavcanPublish(UAVCAN_EQUIPMENT_DEVICE_TEMPERATURE_SIGNATURE, UAVCAN_EQUIPMENT_DEVICE_TEMPERATURE_ID,
+                             transfer_id, CANARD_TRANSFER_PRIORITY_LOW, payload, len);
+    };
+    auto locked_spin = [&]() {
+        std::lock_guard<std::mutex> lock(mutex);
+        uavcanSpinOnce();
+    };
+    auto async_publish = [](uint8_t* transfer_id, const uint8_t* payload, uint16_t len) {
+        return uavcanPublishAsync(UAVCAN_EQUIPMENT_DEVICE_TEMPERATURE_SIGNATURE, UAVCAN_EQUIPMENT_DEVICE_TEMPERATURE_ID,
+                                  transfer_id, CANARD_TRANSFER_PRIORITY_LOW, payload, len);
+    };
+    auto async_spin = []() {
+        uavcanSpinOnce();
+    };
+
+    const uint8_t threads[] = {1, 2, 4, 8};
+    char name[64];
+    for (auto number_of_threads : threads) {
+        snprintf(name, sizeof(name), "%u threads: mutex + uavcanPublish", number_of_threads);
+        double locked_ns = runContention(name, number_of_threads, locked_publish, locked_spin);
+
+        snprintf(name, sizeof(name), "%u threads: uavcanPublishAsync", number_of_threads);
+        double async_ns = runContention(name, number_of_threads, async_publish, async_spin);
+        printf("%-48s %10.1f x\n", "publish call speedup", locked_ns / async_ns);
+    }
+
+    printf("%-48s %10llu\n", "frames sent", (unsigned long long)number_of_sent_frames.load());
+    printf("%-48s %10u\n", "publish queue drops", uavcanGetPublishQueueDropCount());
+    return 0;
+}
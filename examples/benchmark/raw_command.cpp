@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2025 Dmitry Ponomarev <ponomarevda96@gmail.com>
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+/**
+ * @brief Compare the full RawCommand decode with the decode of selected channels only.
+ * The transfers are produced by a real libcanard instance, so multi-frame payloads are scattered
+ * over the pool blocks the same way as on a node.
+ */
+#include <cstdio>
+#include "common.hpp"
+#include "libdcnode/uavcan/equipment/esc/RawCommand.h"
+
+static constexpr uint32_t ITERATIONS = 1000000;
+
+static CanardInstance tx_ins;
+static CanardInstance rx_ins;
+static uint8_t tx_buffer[2048];
+static uint8_t rx_buffer[2048];
+static uint8_t number_of_channels = 0;
+
+static bool shouldAccept(const CanardInstance*, uint64_t* out_signature, uint16_t data_type_id,
+                         CanardTransferType, uint8_t) {
+    *out_signature = UAVCAN_EQUIPMENT_ESC_RAWCOMMAND_SIGNATURE;
+    return data_type_id == UAVCAN_EQUIPMENT_ESC_RAWCOMMAND_ID;
+}
+
+static void onTransfer(CanardInstance*, CanardRxTransfer* transfer) {
+    char name[64];
+    RawCommand_t msg{};
+
+    snprintf(name, sizeof(name), "%u channels: full decode", number_of_channels);
+    double full_ns = benchmarkRun(name, ITERATIONS, [&]() {
+        dronecan_equipment_esc_raw_command_deserialize(transfer, &msg);
+        benchmarkDoNotOptimize(msg);
+    });
+
+    const uint32_t masks[] = {0x1, 0xF, 0xFF};
+    for (auto mask : masks) {
+        snprintf(name, sizeof(name), "%u channels: masked decode, mask=0x%02X",
+                 number_of_channels, (unsigned)mask);
+        double masked_ns = benchmarkRun(name, ITERATIONS, [&]() {
+            dronecan_equipment_esc_raw_command_masked_deserialize(transfer, mask, &msg);
+            benchmarkDoNotOptimize(msg);
+        });
+        printf("%-48s %10.1f x\n", "speedup", full_ns / masked_ns);
+    }
+}
+
+static void transmitRawCommand(uint8_t channels) {
+    static uint8_t transfer_id = 0;
+    RawCommand_t msg{};
+    for (uint8_t ch = 0; ch < channels; ch++) {
+        msg.raw_cmd[ch] = static_cast<int16_t>(ch * 400 - 4000);
+    }
+
+    uint8_t payload[RAWCOMMAND_MAX_PAYLOAD_SIZE];
+    size_t payload_len = sizeof(payload);
+    dronecan_equipment_esc_raw_command_serialize(&msg, payload, &payload_len, channels);
+    canardBroadcast(&tx_ins, UAVCAN_EQUIPMENT_ESC_RAWCOMMAND_SIGNATURE, UAVCAN_EQUIPMENT_ESC_RAWCOMMAND_ID,
+                    &transfer_id, CANARD_TRANSFER_PRIORITY_MEDIUM, payload, (channels * RAWCOMMAND_BIT_LEN + 7) / 8);
+
+    number_of_channels = channels;
+    uint64_t timestamp_usec = 1000000;
+    for (const CanardCANFrame* frame = canardPeekTxQueue(&tx_ins); frame; frame = canardPeekTxQueue(&tx_ins)) {
+        canardHandleRxFrame(&rx_ins, frame, timestamp_usec++);
+        canardPopTxQueue(&tx_ins);
+    }
+}
+
+int main() {
+    canardInit(&tx_ins, tx_buffer, sizeof(tx_buffer), nullptr, nullptr, nullptr);
+    canardSetLocalNodeID(&tx_ins, 10);
+    canardInit(&rx_ins, rx_buffer, sizeof(rx_buffer), onTransfer, shouldAccept, nullptr);
+    canardSetLocalNodeID(&rx_ins, 42);
+
+    const uint8_t channels[] = {4, 8, NUMBER_OF_RAW_CMD_CHANNELS};
+    for (auto number : channels) {
+        transmitRawCommand(number);
+    }
+
+    return 0;
+}
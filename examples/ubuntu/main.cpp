@@ -100,27 +100,11 @@ void rc2_callback(const RawCommand_t& msg) {
     std::cout << "Get RawCommand 2 with " << (int)msg.size << " commands." << std::endl;
 }
 
-void ac1_callback(const ArrayCommand_t& msg) {
-    std::cout << "Get ArrayCommand_t1 with " << msg.size << "commands." << std::endl;
+void actuator0_callback(const Command_t& cmd) {
+    std::cout << "Get actuator 0 command " << cmd.command_value << std::endl;
 }
-void ac2_callback(const ArrayCommand_t& msg) {
-    std::cout << "Get ArrayCommand_t2 with " << msg.size << "commands." << std::endl;
-}
-bool ac1_filter(const ArrayCommand_t& msg) {
-    for (size_t idx = 0; idx < msg.size; idx++) {
-        if (msg.commads[idx].actuator_id == 0) {
-            return true;
-        }
-    }
-    return false;
-}
-bool ac2_filter(const ArrayCommand_t& msg) {
-    for (size_t idx = 0; idx < msg.size; idx++) {
-        if (msg.commads[idx].actuator_id == 1) {
-            return true;
-        }
-    }
-    return false;
+void actuator1_callback(const Command_t& cmd) {
+    std::cout << "Get actuator 1 command " << cmd.command_value << std::endl;
 }
 
 void lights_callback(const LightsCommand_t& msg) {
@@ -164,6 +148,7 @@ int main() {
             .send = canDriverTransmit,
             .getRxOverflowCount = canDriverGetRxOverflowCount,
             .getErrorCount = canDriverGetErrorCount,
+            .recvTimestamped = canDriverReceiveTimestamped,
         }
     };
 
@@ -186,11 +171,10 @@ int main() {
     DronecanSubscriber<LightsCommand_t> lights_command_sub;
     lights_command_sub.init(&lights_callback);
 
-    DronecanSubscriber<ArrayCommand_t> array_command_sub1;
-    array_command_sub1.init(&ac1_callback, &ac1_filter);
-
-    DronecanSubscriber<ArrayCommand_t> array_command_sub2;
-    array_command_sub2.init(&ac2_callback, &ac2_filter);
+    DronecanArrayCommandDispatcher<> array_command_dispatcher;
+    array_command_dispatcher.addHandler(0, &actuator0_callback);
+    array_command_dispatcher.addHandler(1, &actuator1_callback);
+    array_command_dispatcher.init();
 
     DronecanSubscriber<RawCommand_t> raw_command_sub1;
     raw_command_sub1.init(&rc1_callback);
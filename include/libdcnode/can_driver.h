@@ -31,6 +31,15 @@ int16_t canDriverInit(uint32_t can_speed, uint8_t can_driver_idx);
 
 int16_t canDriverReceive(CanardCANFrame* const rx_frame, uint8_t can_driver_idx);
 
+/*
+* @brief Same as canDriverReceive, also reports when the frame arrived. On input *inout_timestamp_usec is
+* the current time of the node, a driver that buffers the frames moves it back by the time the frame waited,
+* a driver that doesn't know it leaves the time as is.
+*/
+int16_t canDriverReceiveTimestamped(CanardCANFrame* const rx_frame,
+                                    uint64_t* inout_timestamp_usec,
+                                    uint8_t can_driver_idx);
+
 int16_t canDriverTransmit(const CanardCANFrame* const tx_frame, uint8_t can_driver_idx);
 
 /*
@@ -51,6 +60,14 @@ inline CanProtocol canDriverGetProtocol(uint8_t can_driver_idx) {
 uint64_t canDriverGetRxOverflowCount();
 uint64_t canDriverGetErrorCount();
 
+/*
+* @brief With CAN_DRIVER_RX_INTERRUPT enabled, the driver receives in the RX interrupt:
+* the frames of the fast subscriptions are dispatched immediately, the others are buffered
+* for canDriverReceive. The bxcan driver requires calling it from CANx_RX0_IRQHandler and CANx_RX1_IRQHandler.
+* The fdcan driver receives in HAL_FDCAN_RxFifo0Callback instead.
+*/
+void canDriverRxIrqHandler(uint8_t can_driver_idx);
+
 #ifdef __cplusplus
 }
 #endif
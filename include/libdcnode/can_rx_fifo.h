@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2025 Dmitry Ponomarev <ponomarevda96@gmail.com>
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef LIBDCNODE_CAN_RX_FIFO_H_
+#define LIBDCNODE_CAN_RX_FIFO_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <assert.h>
+#include "libdcnode/internal.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef CAN_RX_FIFO_SIZE
+    #define CAN_RX_FIFO_SIZE    32
+#endif
+static_assert(CAN_RX_FIFO_SIZE <= 128 && (CAN_RX_FIFO_SIZE & (CAN_RX_FIFO_SIZE - 1)) == 0,
+              "CAN_RX_FIFO_SIZE must be a power of two not greater than 128");
+
+/**
+  * @brief Frames moved by the RX interrupt from the CAN peripheral to the main loop.
+  * The interrupt only pushes and the main loop only pops, so no critical section is needed on a single core.
+  */
+typedef struct {
+    CanardCANFrame frames[CAN_RX_FIFO_SIZE];
+    volatile uint8_t head;
+    volatile uint8_t tail;
+    volatile uint32_t overflow_count;
+} CanRxFifo;
+
+static inline bool canRxFifoPush(CanRxFifo* fifo, const CanardCANFrame* frame) {
+    const uint8_t head = fifo->head;
+    if ((uint8_t)(head - fifo->tail) >= CAN_RX_FIFO_SIZE) {
+        fifo->overflow_count++;
+        return false;
+    }
+
+    fifo->frames[head & (CAN_RX_FIFO_SIZE - 1U)] = *frame;
+    __asm__ volatile("" ::: "memory");
+    fifo->head = head + 1U;
+    return true;
+}
+
+static inline bool canRxFifoPop(CanRxFifo* fifo, CanardCANFrame* out_frame) {
+    const uint8_t tail = fifo->tail;
+    if (tail == fifo->head) {
+        return false;
+    }
+
+    __asm__ volatile("" ::: "memory");
+    *out_frame = fifo->frames[tail & (CAN_RX_FIFO_SIZE - 1U)];
+    __asm__ volatile("" ::: "memory");
+    fifo->tail = tail + 1U;
+    return true;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LIBDCNODE_CAN_RX_FIFO_H_
@@ -0,0 +1,276 @@
+/*
+ * Copyright (C) 2025 Dmitry Ponomarev <ponomarevda96@gmail.com>
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef LIBDCNODE_COROUTINE_HPP_
+#define LIBDCNODE_COROUTINE_HPP_
+
+#if __cplusplus < 202002L || !__has_include(<coroutine>)
+    #error "libdcnode/coroutine.hpp requires C++20 coroutines"
+#endif
+
+#include <stdint.h>
+#include <array>
+#include <coroutine>
+#include <exception>
+#include <utility>
+#include "libdcnode/dronecan.h"
+#include "libdcnode/subscriber.hpp"
+
+/**
+ * @brief A top-level coroutine run by DronecanScheduler, e.g.
+ * DronecanTask blink(Scheduler& scheduler) { while (true) { co_await scheduler.sleep(500); toggleLed(); } }
+ * The task starts on the next DronecanScheduler::spinOnce after spawn.
+ * @note The coroutine frame is allocated on the heap when the task is created.
+ * GCC 12 reports -Wswitch-default for the code it generates for a coroutine, so disable this warning.
+ */
+class DronecanTask {
+public:
+    struct promise_type {
+        DronecanTask get_return_object() {
+            return DronecanTask(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() noexcept {
+            return {};
+        }
+        std::suspend_always final_suspend() noexcept {
+            return {};
+        }
+        void return_void() {}
+        void unhandled_exception() {
+            std::terminate();
+        }
+    };
+
+    DronecanTask(DronecanTask&& other) noexcept : handle(std::exchange(other.handle, {})) {}
+    DronecanTask(const DronecanTask&) = delete;
+    DronecanTask& operator=(const DronecanTask&) = delete;
+    ~DronecanTask() {
+        if (handle) {
+            handle.destroy();
+        }
+    }
+
+    std::coroutine_handle<> release() {
+        return std::exchange(handle, {});
+    }
+
+private:
+    explicit DronecanTask(std::coroutine_handle<promise_type> handle_) : handle(handle_) {}
+
+    std::coroutine_handle<promise_type> handle;
+};
+
+/**
+ * @brief Single-threaded scheduler of DronecanTask. spinOnce spins the node and then resumes only
+ * the tasks whose event fired: an expired sleep, a received message or free space in the TX queue.
+ * The awaitables may be used only in the body of a spawned task, not in a nested coroutine.
+ */
+template <uint8_t MAX_TASKS = 16>
+class DronecanScheduler {
+public:
+    DronecanScheduler() = default;
+    DronecanScheduler(const DronecanScheduler&) = delete;
+    DronecanScheduler& operator=(const DronecanScheduler&) = delete;
+    ~DronecanScheduler() {
+        for (auto& slot : slots) {
+            if (slot.handle) {
+                slot.handle.destroy();
+            }
+        }
+    }
+
+    /**
+     * @return 0 on success, -1 if there are already MAX_TASKS tasks
+     */
+    int8_t spawn(DronecanTask task) {
+        for (auto& slot : slots) {
+            if (!slot.handle) {
+                slot.handle = task.release();
+                slot.state = State::READY;
+                number_of_tasks++;
+                return 0;
+            }
+        }
+        return -1;
+    }
+
+    void spinOnce() {
+        uavcanSpinOnce();
+
+        uint32_t crnt_time_ms = uavcanPlatformGetTimeMs();
+        uint16_t free_tx_frames = uavcanGetFreeTxFrames();
+        for (uint8_t idx = 0; idx < MAX_TASKS; idx++) {
+            Slot& slot = slots[idx];
+            if (slot.state == State::SLEEPING && static_cast<int32_t>(crnt_time_ms - slot.deadline_ms) >= 0) {
+                slot.state = State::READY;
+            } else if (slot.state == State::WAITING_TX && free_tx_frames >= slot.tx_frames) {
+                slot.state = State::READY;
+            }
+
+            if (slot.state != State::READY) {
+                continue;
+            }
+
+            slot.state = State::RUNNING;
+            current_slot = idx;
+            slot.handle.resume();
+            current_slot = NO_SLOT;
+            if (slot.handle.done()) {
+                slot.handle.destroy();
+                slot.handle = {};
+                slot.state = State::FREE;
+                number_of_tasks--;
+            }
+        }
+    }
+
+    /**
+     * @brief co_await scheduler.sleep(period_ms). Zero yields until the next spinOnce.
+     */
+    auto sleep(uint32_t duration_ms) {
+        struct Awaiter {
+            DronecanScheduler* scheduler;
+            uint32_t duration_ms;
+            bool await_ready() const noexcept {
+                return false;
+            }
+            void await_suspend(std::coroutine_handle<>) {
+                Slot& slot = scheduler->slots[scheduler->suspendRunning(State::SLEEPING)];
+                slot.deadline_ms = uavcanPlatformGetTimeMs() + duration_ms;
+            }
+            void await_resume() const noexcept {}
+        };
+        return Awaiter{this, duration_ms};
+    }
+
+    /**
+     * @brief co_await scheduler.txSpace(frames) before publishing a burst, so no transfer is dropped
+     */
+    auto txSpace(uint16_t frames = 1) {
+        struct Awaiter {
+            DronecanScheduler* scheduler;
+            uint16_t frames;
+            bool await_ready() const noexcept {
+                return uavcanGetFreeTxFrames() >= frames;
+            }
+            void await_suspend(std::coroutine_handle<>) {
+                scheduler->slots[scheduler->suspendRunning(State::WAITING_TX)].tx_frames = frames;
+            }
+            void await_resume() const noexcept {}
+        };
+        return Awaiter{this, frames};
+    }
+
+    /**
+     * @brief Suspend the running task until wake(slot) is called. Used by the awaitables.
+     * @return the slot of the task
+     */
+    uint8_t waitForEvent() {
+        return suspendRunning(State::WAITING_EVENT);
+    }
+
+    void wake(uint8_t slot) {
+        if (slot < MAX_TASKS && slots[slot].state == State::WAITING_EVENT) {
+            slots[slot].state = State::READY;
+        }
+    }
+
+    uint8_t getNumberOfTasks() const {
+        return number_of_tasks;
+    }
+
+    static constexpr uint8_t NO_SLOT = 0xFF;
+
+private:
+    enum class State : uint8_t {
+        FREE,
+        READY,
+        RUNNING,
+        SLEEPING,
+        WAITING_TX,
+        WAITING_EVENT,
+    };
+
+    struct Slot {
+        std::coroutine_handle<> handle;
+        uint32_t deadline_ms{0};
+        uint16_t tx_frames{0};
+        State state{State::FREE};
+    };
+
+    uint8_t suspendRunning(State state) {
+        if (current_slot == NO_SLOT) {
+            std::terminate();  // an awaitable is used outside of a task spawned by this scheduler
+        }
+        slots[current_slot].state = state;
+        return current_slot;
+    }
+
+    std::array<Slot, MAX_TASKS> slots{};
+    uint8_t number_of_tasks{0};
+    uint8_t current_slot{NO_SLOT};
+};
+
+/**
+ * @brief Subscriber for tasks: co_await sub.next() suspends the task until the next message.
+ * Only one task may wait for a subscriber at a time. The messages received while no task waits
+ * are dropped, and if several arrive within one spin, the task gets the latest.
+ */
+template <typename MessageType, typename Scheduler>
+class DronecanAwaitableSubscriber : public DronecanSubscription {
+public:
+    DronecanAwaitableSubscriber() = default;
+
+    int8_t init(Scheduler* scheduler_, const DronecanRawFilter& raw_filter_=DronecanRawFilter()) {
+        scheduler = scheduler_;
+        raw_filter = raw_filter_;
+        sub_id = DronecanSubscriberTraits<MessageType>::subscribe(transfer_callback);
+        if (sub_id >= 0) {
+            registerInstance(instances, this);
+        }
+        return sub_id;
+    }
+
+    static inline void transfer_callback(CanardRxTransfer* transfer) {
+        auto instance = static_cast<DronecanAwaitableSubscriber*>(instances[transfer->sub_id]);
+        if (instance == nullptr || instance->waiting_slot == Scheduler::NO_SLOT ||
+                !instance->raw_filter.match(transfer)) {
+            return;
+        }
+
+        if (DronecanSubscriberTraits<MessageType>::deserialize(transfer, &instance->msg) < 0) {
+            return;
+        }
+
+        instance->scheduler->wake(instance->waiting_slot);
+    }
+
+    auto next() {
+        struct Awaiter {
+            DronecanAwaitableSubscriber* subscriber;
+            bool await_ready() const noexcept {
+                return false;
+            }
+            void await_suspend(std::coroutine_handle<>) {
+                subscriber->waiting_slot = subscriber->scheduler->waitForEvent();
+            }
+            MessageType await_resume() {
+                subscriber->waiting_slot = Scheduler::NO_SLOT;
+                return subscriber->msg;
+            }
+        };
+        return Awaiter{this};
+    }
+
+    static inline std::array<void*, DRONECAN_MAX_SUBS_NUMBER> instances{};
+    Scheduler* scheduler{nullptr};
+    DronecanRawFilter raw_filter;
+    MessageType msg = {};
+    uint8_t waiting_slot{Scheduler::NO_SLOT};
+};
+
+#endif  // LIBDCNODE_COROUTINE_HPP_
@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2025 Dmitry Ponomarev <ponomarevda96@gmail.com>
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef LIBDCNODE_DELEGATE_HPP_
+#define LIBDCNODE_DELEGATE_HPP_
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#ifndef DRONECAN_DELEGATE_CAPACITY
+    #define DRONECAN_DELEGATE_CAPACITY  (2 * sizeof(void*))
+#endif
+
+template <typename Signature, size_t CAPACITY = DRONECAN_DELEGATE_CAPACITY>
+class DronecanDelegate;
+
+/**
+ * @brief Callable wrapper that keeps a function pointer, a member function bound to an object
+ * or a small lambda inline, without heap allocation.
+ * The captures must be trivially copyable and fit CAPACITY bytes, which is checked at compile time.
+ * A call costs one indirect call, the same as a plain function pointer.
+ */
+template <typename Return, typename... Args, size_t CAPACITY>
+class DronecanDelegate<Return(Args...), CAPACITY> {
+public:
+    DronecanDelegate() = default;
+    DronecanDelegate(std::nullptr_t) {}  // NOLINT(runtime/explicit)
+
+    DronecanDelegate(Return (*function)(Args...)) {  // NOLINT(runtime/explicit)
+        if (function != nullptr) {
+            store(function);
+        }
+    }
+
+    template <typename Callable, typename = std::enable_if_t<
+        !std::is_same_v<std::decay_t<Callable>, DronecanDelegate> &&
+        std::is_invocable_r_v<Return, std::decay_t<Callable>&, Args...>>>
+    DronecanDelegate(Callable&& callable) {  // NOLINT(runtime/explicit)
+        store(std::forward<Callable>(callable));
+    }
+
+    /**
+     * @brief Bind a member function, e.g. DronecanDelegate<void(const RawCommand_t&)>::bind<&Motor::onCommand>(&motor)
+     */
+    template <auto Method, typename Class>
+    static DronecanDelegate bind(Class* object) {
+        return DronecanDelegate([object](Args... args) -> Return {
+            return (object->*Method)(std::forward<Args>(args)...);
+        });
+    }
+
+    Return operator()(Args... args) const {
+        return invoker(storage, std::forward<Args>(args)...);
+    }
+
+    explicit operator bool() const {
+        return invoker != nullptr;
+    }
+
+private:
+    template <typename Callable>
+    void store(Callable&& callable) {
+        using Stored = std::decay_t<Callable>;
+        static_assert(sizeof(Stored) <= CAPACITY, "The callable is too big, increase the delegate capacity");
+        static_assert(alignof(Stored) <= ALIGNMENT, "The callable is over-aligned");
+        static_assert(std::is_trivially_copyable_v<Stored> && std::is_trivially_destructible_v<Stored>,
+                      "The captures must be trivially copyable, e.g. pointers, references and numbers");
+
+        new (storage) Stored(std::forward<Callable>(callable));
+        invoker = [](void* object, Args... args) -> Return {
+            return (*static_cast<Stored*>(object))(std::forward<Args>(args)...);
+        };
+    }
+
+    static constexpr size_t ALIGNMENT = alignof(void*) > alignof(double) ? alignof(void*) : alignof(double);
+
+    alignas(ALIGNMENT) mutable unsigned char storage[CAPACITY]{};
+    Return (*invoker)(void*, Args...){nullptr};
+};
+
+#endif  // LIBDCNODE_DELEGATE_HPP_
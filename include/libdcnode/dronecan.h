@@ -24,6 +24,56 @@ extern "C" {
     #define DRONECAN_MAX_SUBS_NUMBER    10
 #endif
 
+#ifndef DRONECAN_MAX_STREAM_SUBS_NUMBER
+    #define DRONECAN_MAX_STREAM_SUBS_NUMBER    2
+#endif
+
+#ifndef DRONECAN_MAX_FAST_SUBS_NUMBER
+    #define DRONECAN_MAX_FAST_SUBS_NUMBER      2
+#endif
+
+/**
+  * @brief The RX staging buffer is disabled by default and the frames are handled in the order of arrival.
+  * Set its size to dispatch the pending frames in the order of CAN ID priority.
+  */
+#ifndef DRONECAN_RX_STAGING_SIZE
+    #define DRONECAN_RX_STAGING_SIZE           0
+#endif
+
+#ifndef DRONECAN_MAX_SHEDDABLE_TYPES
+    #define DRONECAN_MAX_SHEDDABLE_TYPES       4
+#endif
+
+/**
+  * @brief The publish queue is disabled by default. Set its size to a power of two, at least 2, to enable it.
+  */
+#ifndef DRONECAN_PUBLISH_QUEUE_SIZE
+    #define DRONECAN_PUBLISH_QUEUE_SIZE    0
+#endif
+
+#ifndef DRONECAN_PUBLISH_QUEUE_PAYLOAD_SIZE
+    #define DRONECAN_PUBLISH_QUEUE_PAYLOAD_SIZE    128
+#endif
+
+/**
+  * @brief The number of service requests sent by uavcanRequest that may wait for a response at the same time
+  */
+#ifndef DRONECAN_MAX_PENDING_REQUESTS
+    #define DRONECAN_MAX_PENDING_REQUESTS      8
+#endif
+
+/**
+  * @brief A set of node IDs 0..127 stored as a bitmap
+  */
+#define DRONECAN_NODE_SET_WORDS         4
+
+static inline void uavcanNodeSetAdd(uint32_t node_set[DRONECAN_NODE_SET_WORDS], uint8_t node_id) {
+    node_set[(node_id >> 5) & 3U] |= 1UL << (node_id & 31U);
+}
+static inline bool uavcanNodeSetContains(const uint32_t node_set[DRONECAN_NODE_SET_WORDS], uint8_t node_id) {
+    return (node_set[(node_id >> 5) & 3U] >> (node_id & 31U)) & 1U;
+}
+
 typedef struct {
     uint8_t node_id;
     const char* node_name;
@@ -40,6 +90,9 @@ typedef void (*PlatformSpecificReadUniqueIDFunc)(uint8_t out_uid[16]);
 
 typedef int16_t (*CanDriverInitFunc)(uint32_t can_speed, uint8_t can_driver_idx);
 typedef int16_t (*CanDriverReceiveFunc)(CanardCANFrame* const rx_frame, uint8_t can_driver_idx);
+typedef int16_t (*CanDriverReceiveTimestampedFunc)(CanardCANFrame* const rx_frame,
+                                                   uint64_t* inout_timestamp_usec,
+                                                   uint8_t can_driver_idx);
 typedef int16_t (*CanDriverTransmitFunc)(const CanardCANFrame* const tx_frame, uint8_t can_driver_idx);
 typedef uint64_t (*CanDriverGetRxOverflowCountFunc)(void);
 typedef uint64_t (*CanDriverGetErrorCountFunc)(void);
@@ -50,6 +103,7 @@ typedef struct {
     CanDriverTransmitFunc send;
     CanDriverGetRxOverflowCountFunc getRxOverflowCount;
     CanDriverGetErrorCountFunc getErrorCount;
+    CanDriverReceiveTimestampedFunc recvTimestamped;    ///< optional, see canDriverReceiveTimestamped
 } CanDriverApi;
 
 typedef struct {
@@ -60,6 +114,49 @@ typedef struct {
     CanDriverApi can;
 } PlatformApi;
 
+/**
+  * @brief By default the library calls the platform, the CAN driver and the parameters through the
+  * PlatformApi and ParamsApi tables. With DRONECAN_STATIC_BINDING it calls the functions below and
+  * the CAN driver of can_driver.h directly, so the compiler can inline them with LTO.
+  * The tables passed to uavcanInitApplication are ignored then.
+  */
+#ifndef DRONECAN_STATIC_BINDING
+    #define DRONECAN_STATIC_BINDING     0
+#endif
+
+#if DRONECAN_STATIC_BINDING
+uint32_t platformSpecificGetTimeMs(void);
+bool platformSpecificRequestRestart(void);
+void platformSpecificReadUniqueID(uint8_t out_uid[16]);
+
+const char* paramsGetName(ParamIndex_t param_idx);
+bool paramsIsInteger(ParamIndex_t param_idx);
+bool paramsIsString(ParamIndex_t param_idx);
+ParamIndex_t paramsFind(const uint8_t* name, uint16_t len);
+int8_t paramsSave(void);
+int8_t paramsResetToDefault(void);
+void paramsSetIntegerValue(ParamIndex_t param_idx, IntegerParamValue_t param_value);
+IntegerParamValue_t paramsGetIntegerValue(ParamIndex_t param_idx);
+IntegerParamValue_t paramsGetIntegerMin(ParamIndex_t param_idx);
+IntegerParamValue_t paramsGetIntegerMax(ParamIndex_t param_idx);
+IntegerParamValue_t paramsGetIntegerDef(ParamIndex_t param_idx);
+uint8_t paramsSetStringValue(ParamIndex_t param_idx, uint8_t str_len, const StringParamValue_t param_value);
+StringParamValue_t* paramsGetStringValue(ParamIndex_t param_idx);
+#endif
+
+extern PlatformApi platform;
+
+/**
+  * @brief The time source of the library and the C++ helpers
+  */
+static inline uint32_t uavcanPlatformGetTimeMs(void) {
+#if DRONECAN_STATIC_BINDING
+    return platformSpecificGetTimeMs();
+#else
+    return platform.getTimeMs();
+#endif
+}
+
 /**
   * @brief Initialize the node and minimal required services
   * @return 0 on success, otherwise negative error
@@ -84,6 +181,94 @@ int8_t uavcanSubscribe(uint64_t signature,
                        uint16_t id,
                        void (callback)(CanardRxTransfer* transfer));
 
+/**
+  * @brief Accept the transfers of the subscription only from the given source nodes.
+  * The check is done before a multi-frame transfer is reassembled.
+  * By default all nodes are allowed. NULL allows all nodes again.
+  * @return 0 on success, otherwise negative error
+  */
+int8_t uavcanSetAllowedSourceNodes(int8_t sub_id, const uint32_t allowed_nodes[DRONECAN_NODE_SET_WORDS]);
+
+/**
+  * @brief Callbacks of a frame-by-frame decoder.
+  * The transfer argument has the metadata and sub_id of the stream subscription, but no payload.
+  * on_end is called with is_valid=false if the transfer was broken or its CRC didn't match,
+  * so the decoder should discard everything decoded since on_start.
+  */
+typedef struct {
+    void (*on_start)(const CanardRxTransfer* transfer);
+    void (*on_bytes)(const CanardRxTransfer* transfer, const uint8_t* data, uint8_t len);
+    void (*on_end)(CanardRxTransfer* transfer, bool is_valid);
+} UavcanStreamCallbacks;
+
+/**
+  * @brief Subscribe with a decoder that receives the payload frame by frame, as it arrives.
+  * The transfers of this data type don't use the libcanard memory pool and can't be received by
+  * regular subscriptions. One transfer at a time is received per stream subscription.
+  * @return stream sub_id on success, otherwise negative error
+  */
+int8_t uavcanSubscribeStream(uint64_t signature, uint16_t id, const UavcanStreamCallbacks* callbacks);
+
+/**
+  * @brief Subscribe to a single-frame message that is dispatched right from the CAN RX interrupt
+  * by uavcanHandleFrameFromIsr. The callback runs in the interrupt context with a transfer that
+  * doesn't use the libcanard memory pool, so it may only deserialize the transfer and must not call
+  * the other functions of this API. Multi-frame transfers of this type are reassembled by uavcanSpinOnce
+  * with the signature and passed to the same callback from its context, so the callback may be
+  * interrupted by itself. Fast subscriptions should be added before the RX interrupt is enabled.
+  * A data type is delivered either to its fast subscription or to the regular ones, never to both:
+  * uavcanSubscribeFast fails for a data type that has a regular subscription, and uavcanSubscribe fails
+  * for a data type that has a fast subscription.
+  * @return fast sub_id on success, otherwise negative error
+  */
+int8_t uavcanSubscribeFast(uint64_t signature, uint16_t id, void (*callback)(CanardRxTransfer*));
+
+/**
+  * @brief Dispatch a received frame to a fast subscription. Called by a CAN driver from the RX interrupt.
+  * The function is reentrant: it reads only the fast subscriptions table and doesn't touch the node state.
+  * @return true if the frame is consumed, false if it should be passed to uavcanSpinOnce as usual
+  */
+bool uavcanHandleFrameFromIsr(const CanardCANFrame* frame, uint64_t timestamp_usec);
+
+/**
+  * @return the number of multi-frame transfers of the fast subscriptions passed to uavcanSpinOnce
+  */
+uint32_t uavcanGetFastFallbackCount();
+
+typedef struct {
+    uint32_t shed_frames;       ///< frames of the sheddable types dropped under overload
+    uint32_t dropped_frames;    ///< other frames dropped, the spin leaves them in the driver instead, so 0 normally
+    uint8_t size;               ///< frames waiting in the staging buffer
+    uint8_t peak_size;
+} UavcanRxStagingStats;
+
+/**
+  * @brief Mark a message type as low-priority traffic, e.g. uavcan.protocol.debug.LogMessage.
+  * When the RX staging buffer is full, the frames of such types are dropped first.
+  * @return 0 on success, otherwise negative error, e.g. if the library is built without DRONECAN_RX_STAGING_SIZE
+  */
+int8_t uavcanAddSheddableType(uint16_t data_type_id);
+
+const UavcanRxStagingStats* uavcanGetRxStagingStats();
+
+/**
+  * @brief Remove the subscription. Its sub_id may be reused by the next uavcanSubscribe.
+  * @return 0 on success, otherwise negative error
+  */
+int8_t uavcanUnsubscribe(int8_t sub_id);
+
+/**
+  * @brief Pause and resume the subscription. A subscription is enabled by default.
+  * Disabled subscriptions don't accept transfers and release the RX states of their data type
+  * if no other enabled subscription uses it. The broadcast states of a fast subscription and the response
+  * states of the client are kept. The states are released immediately, except from a callback of the same
+  * data type: then uavcanSpinOnce releases them after the reception, so a subscription may disable itself.
+  * @return 0 on success, otherwise negative error
+  */
+int8_t uavcanEnableSubscription(int8_t sub_id);
+int8_t uavcanDisableSubscription(int8_t sub_id);
+bool uavcanIsSubscriptionEnabled(int8_t sub_id);
+
 
 /**
   * @brief Broadcast a message.
@@ -95,6 +280,32 @@ int16_t uavcanPublish(uint64_t data_type_signature,
                       const void* payload,
                       uint16_t payload_len);
 
+/**
+  * @brief Broadcast a message from any thread. The serialized transfer is copied into a lock-free
+  * queue and moved into the TX queue by the next uavcanSpinOnce. The transfer id is taken and
+  * incremented immediately, so each publishing thread should own its inout_transfer_id.
+  * @return 0 on success, -CANARD_ERROR_OUT_OF_MEMORY if the queue is full,
+  * -CANARD_ERROR_INVALID_ARGUMENT if the queue is disabled or the payload doesn't fit a slot
+  */
+int16_t uavcanPublishAsync(uint64_t data_type_signature,
+                           uint16_t data_type_id,
+                           uint8_t* inout_transfer_id,
+                           uint8_t priority,
+                           const void* payload,
+                           uint16_t payload_len);
+
+/**
+  * @brief The number of uavcanPublishAsync transfers rejected because the publish queue was full
+  * or failed to be moved into the TX queue
+  */
+uint32_t uavcanGetPublishQueueDropCount();
+
+/**
+  * @brief The number of frames that can be added to the TX queue right now.
+  * The libcanard memory pool is shared with the RX transfers, so it may shrink without a publication.
+  */
+uint16_t uavcanGetFreeTxFrames();
+
 
 /**
   * @brief Respond on RPC-request.
@@ -105,6 +316,66 @@ void uavcanRespond(CanardRxTransfer* transfer,
                    const uint8_t* payload,
                    uint16_t len);
 
+/**
+  * @brief Called once per request: with the response, or with NULL transfer when the request timed out
+  */
+typedef void (*UavcanResponseCallback)(CanardRxTransfer* transfer, uint8_t server_node_id, void* user_data);
+
+/**
+  * @brief Call a service of another node. The request is kept in a table of outstanding requests
+  * until the response with the same server node, data type and transfer id arrives or timeout_ms expires.
+  * The callback is called from uavcanSpinOnce. Responses are never passed to the subscriptions,
+  * and a response that matches no outstanding request, e.g. a late one, is dropped.
+  * @return 0 on success, -CANARD_ERROR_OUT_OF_MEMORY if the table or the TX queue is full,
+  * otherwise negative error
+  */
+int16_t uavcanRequest(uint64_t data_type_signature,
+                      uint16_t data_type_id,
+                      uint8_t server_node_id,
+                      uint8_t priority,
+                      const uint8_t* payload,
+                      uint16_t len,
+                      uint32_t timeout_ms,
+                      UavcanResponseCallback callback,
+                      void* user_data);
+
+uint8_t uavcanGetNumberOfPendingRequests();
+
+/**
+  * @brief Everything needed to respond on an RPC-request after its transfer is released
+  */
+typedef struct {
+    uint8_t source_node_id;
+    uint8_t transfer_id;
+    uint8_t priority;
+} UavcanResponseToken;
+
+/**
+  * @brief Leave the request pending instead of responding from the service handler.
+  * The application finishes the work later, e.g. in its own loop or thread,
+  * and then calls uavcanRespondDeferred with the token.
+  * @note The client gives up after its own timeout, typically about 1 second.
+  */
+UavcanResponseToken uavcanDeferResponse(const CanardRxTransfer* transfer);
+
+/**
+  * @brief Respond on a request left pending with uavcanDeferResponse.
+  * Call it from the thread that spins the node.
+  * @return the number of enqueued frames, otherwise negative error
+  */
+int16_t uavcanRespondDeferred(const UavcanResponseToken* token,
+                              uint64_t data_type_signature,
+                              uint16_t data_type_id,
+                              const uint8_t* payload,
+                              uint16_t len);
+
+/**
+  * @brief Finish uavcan.protocol.param.ExecuteOpcode after params.save or params.resetToDefault
+  * returned PARAMS_OPERATION_PENDING.
+  * @param[in] result is 0 on success, otherwise negative error
+  */
+void uavcanParamsCompleteOperation(int8_t result);
+
 
 /**
   * @brief NodeInfo API
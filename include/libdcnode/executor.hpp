@@ -0,0 +1,241 @@
+/*
+ * Copyright (C) 2025 Dmitry Ponomarev <ponomarevda96@gmail.com>
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef LIBDCNODE_EXECUTOR_HPP_
+#define LIBDCNODE_EXECUTOR_HPP_
+
+#include <stdint.h>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "libdcnode/delegate.hpp"
+#include "libdcnode/subscriber.hpp"
+
+/**
+ * @brief What the executor does when the worker queue of a task is full
+ */
+enum class DronecanExecutorPolicy : uint8_t {
+    BLOCK,          ///< wait in the spin thread until the worker takes a task, so the CAN RX buffers fill up instead
+    DROP_NEWEST,    ///< discard the task and count it
+};
+
+/**
+ * @brief Fixed pool of worker threads that runs subscriber callbacks outside of uavcanSpinOnce.
+ * A task is assigned to a worker by its key, so the tasks with the same key run one after another
+ * in the submission order, while the tasks with different keys may run in parallel.
+ * A task is a delegate stored inline in the worker queue, so submitting never allocates: its captures,
+ * e.g. the callback and a copy of the message, must be trivially copyable and fit TASK_CAPACITY bytes,
+ * which is checked at compile time.
+ * @note Requires a hosted platform with std::thread.
+ */
+template <uint8_t MAX_WORKERS = 8, uint16_t QUEUE_CAPACITY = 32, size_t TASK_CAPACITY = 128>
+class DronecanExecutor {
+public:
+    using Task = DronecanDelegate<void(), TASK_CAPACITY>;
+
+    DronecanExecutor() = default;
+    DronecanExecutor(const DronecanExecutor&) = delete;
+    DronecanExecutor& operator=(const DronecanExecutor&) = delete;
+    ~DronecanExecutor() {
+        stop();
+    }
+
+    /**
+     * @return 0 on success, otherwise negative error
+     */
+    int8_t start(uint8_t number_of_workers_, DronecanExecutorPolicy policy_=DronecanExecutorPolicy::BLOCK) {
+        if (number_of_workers != 0 || number_of_workers_ == 0 || number_of_workers_ > MAX_WORKERS) {
+            return -1;
+        }
+
+        policy = policy_;
+        number_of_workers = number_of_workers_;
+        for (uint8_t idx = 0; idx < number_of_workers; idx++) {
+            workers[idx].is_stopping = false;
+            workers[idx].thread = std::thread(&DronecanExecutor::spinWorker, &workers[idx]);
+        }
+        return 0;
+    }
+
+    /**
+     * @brief Run the already submitted tasks and join the workers
+     */
+    void stop() {
+        for (uint8_t idx = 0; idx < number_of_workers; idx++) {
+            Worker& worker = workers[idx];
+            {
+                std::lock_guard<std::mutex> lock(worker.mutex);
+                worker.is_stopping = true;
+            }
+            worker.not_empty.notify_one();
+            worker.not_full.notify_all();
+            worker.thread.join();
+        }
+        number_of_workers = 0;
+    }
+
+    /**
+     * @param[in] key defines the order: the tasks with the same key never run concurrently
+     * @return true if the task is queued, false if it is dropped
+     */
+    bool submit(uint32_t key, const Task& task) {
+        if (number_of_workers == 0) {
+            return false;
+        }
+
+        Worker& worker = workers[key % number_of_workers];
+        std::unique_lock<std::mutex> lock(worker.mutex);
+        if (worker.size == QUEUE_CAPACITY) {
+            if (policy == DronecanExecutorPolicy::DROP_NEWEST) {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            blocked.fetch_add(1, std::memory_order_relaxed);
+            worker.not_full.wait(lock, [&worker]() {
+                return worker.size < QUEUE_CAPACITY || worker.is_stopping;
+            });
+            if (worker.is_stopping) {
+                return false;
+            }
+        }
+
+        worker.tasks[(worker.head + worker.size) % QUEUE_CAPACITY] = task;
+        worker.size++;
+        lock.unlock();
+        worker.not_empty.notify_one();
+        return true;
+    }
+
+    /**
+     * @brief Block until all submitted tasks are finished
+     */
+    void waitIdle() {
+        for (uint8_t idx = 0; idx < number_of_workers; idx++) {
+            Worker& worker = workers[idx];
+            std::unique_lock<std::mutex> lock(worker.mutex);
+            worker.idle.wait(lock, [&worker]() {
+                return worker.size == 0 && !worker.is_busy;
+            });
+        }
+    }
+
+    uint8_t getNumberOfWorkers() const {
+        return number_of_workers;
+    }
+
+    /**
+     * @return the number of tasks dropped with the DROP_NEWEST policy
+     */
+    uint64_t getNumberOfDropped() const {
+        return dropped.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @return how many times the spin thread waited for a worker with the BLOCK policy
+     */
+    uint64_t getNumberOfBlocked() const {
+        return blocked.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Worker {
+        std::thread thread;
+        std::mutex mutex;
+        std::condition_variable not_empty;
+        std::condition_variable not_full;
+        std::condition_variable idle;
+        std::array<Task, QUEUE_CAPACITY> tasks;
+        uint16_t head{0};
+        uint16_t size{0};
+        bool is_busy{false};
+        bool is_stopping{false};
+    };
+
+    static void spinWorker(Worker* worker) {
+        std::unique_lock<std::mutex> lock(worker->mutex);
+        while (true) {
+            worker->not_empty.wait(lock, [worker]() {
+                return worker->size > 0 || worker->is_stopping;
+            });
+            if (worker->size == 0) {
+                break;
+            }
+
+            Task task = worker->tasks[worker->head];
+            worker->head = (worker->head + 1) % QUEUE_CAPACITY;
+            worker->size--;
+            worker->is_busy = true;
+            lock.unlock();
+            worker->not_full.notify_one();
+
+            task();
+
+            lock.lock();
+            worker->is_busy = false;
+            if (worker->size == 0) {
+                worker->idle.notify_all();
+            }
+        }
+        worker->is_busy = false;
+        worker->idle.notify_all();
+    }
+
+    std::array<Worker, MAX_WORKERS> workers;
+    uint8_t number_of_workers{0};
+    DronecanExecutorPolicy policy{DronecanExecutorPolicy::BLOCK};
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<uint64_t> blocked{0};
+};
+
+/**
+ * @brief Deserialize in the spin thread and run the callback on an executor worker.
+ * The messages of one subscription are delivered in the order of reception.
+ */
+template <typename MessageType, typename Executor>
+class DronecanParallelSubscriber : public DronecanSubscription {
+public:
+    DronecanParallelSubscriber() = default;
+
+    int8_t init(Executor* executor_,
+                DronecanDelegate<void(const MessageType&)> callback,
+                const DronecanRawFilter& raw_filter_=DronecanRawFilter()) {
+        executor = executor_;
+        user_callback = callback;
+        raw_filter = raw_filter_;
+        sub_id = DronecanSubscriberTraits<MessageType>::subscribe(transfer_callback);
+        if (sub_id >= 0) {
+            registerInstance(instances, this);
+        }
+        return sub_id;
+    }
+
+    static inline void transfer_callback(CanardRxTransfer* transfer) {
+        auto instance = static_cast<DronecanParallelSubscriber*>(instances[transfer->sub_id]);
+        if (instance == nullptr || !instance->raw_filter.match(transfer)) {
+            return;
+        }
+
+        MessageType msg = {};
+        if (DronecanSubscriberTraits<MessageType>::deserialize(transfer, &msg) < 0) {
+            return;
+        }
+
+        auto callback = instance->user_callback;
+        instance->executor->submit(static_cast<uint32_t>(transfer->sub_id), [callback, msg]() {
+            callback(msg);
+        });
+    }
+
+    static inline std::array<void*, DRONECAN_MAX_SUBS_NUMBER> instances{};
+    Executor* executor{nullptr};
+    DronecanDelegate<void(const MessageType&)> user_callback;
+    DronecanRawFilter raw_filter;
+};
+
+#endif  // LIBDCNODE_EXECUTOR_HPP_
@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2025 Dmitry Ponomarev <ponomarevda96@gmail.com>
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef LIBDCNODE_MESSAGE_POOL_HPP_
+#define LIBDCNODE_MESSAGE_POOL_HPP_
+
+#include <stdint.h>
+
+#ifndef DRONECAN_MESSAGE_POOL_SIZE
+    #define DRONECAN_MESSAGE_POOL_SIZE  4
+#endif
+
+template <typename MessageType>
+class DronecanMessageHandle;
+
+/**
+ * @brief Fixed pool of message buffers shared by all pooled subscribers of one message type.
+ * A buffer is owned by reference-counted handles and returns to the pool when the last handle is released.
+ * @note The pool is not thread-safe, so handles should be used in the thread that spins the node.
+ */
+template <typename MessageType>
+class DronecanMessagePool {
+public:
+    static constexpr uint8_t SIZE = DRONECAN_MESSAGE_POOL_SIZE;
+    static constexpr uint8_t INVALID_IDX = 0xFF;
+    static_assert(SIZE < INVALID_IDX, "Message pool is too big");
+
+    /**
+     * @return a handle to a zero-initialized buffer or an empty handle if the pool is exhausted
+     */
+    static DronecanMessageHandle<MessageType> allocate() {
+        for (uint8_t idx = 0; idx < SIZE; idx++) {
+            if (refcounts[idx] == 0) {
+                buffers[idx] = {};
+                return DronecanMessageHandle<MessageType>(idx);
+            }
+        }
+        allocation_failures++;
+        return DronecanMessageHandle<MessageType>();
+    }
+
+    static uint8_t getNumberOfFreeBuffers() {
+        uint8_t counter = 0;
+        for (uint8_t idx = 0; idx < SIZE; idx++) {
+            counter += (refcounts[idx] == 0) ? 1 : 0;
+        }
+        return counter;
+    }
+
+    static uint32_t getAllocationFailures() {
+        return allocation_failures;
+    }
+
+private:
+    friend class DronecanMessageHandle<MessageType>;
+
+    static inline MessageType buffers[SIZE]{};
+    static inline uint8_t refcounts[SIZE]{};
+    static inline uint32_t allocation_failures{0};
+};
+
+/**
+ * @brief Reference-counted handle to a message stored in DronecanMessagePool.
+ * Copying a handle shares the message without copying it.
+ */
+template <typename MessageType>
+class DronecanMessageHandle {
+    using Pool = DronecanMessagePool<MessageType>;
+
+public:
+    DronecanMessageHandle() = default;
+
+    DronecanMessageHandle(const DronecanMessageHandle& other) : idx(other.idx) {
+        retain();
+    }
+
+    DronecanMessageHandle(DronecanMessageHandle&& other) : idx(other.idx) {
+        other.idx = Pool::INVALID_IDX;
+    }
+
+    DronecanMessageHandle& operator=(const DronecanMessageHandle& other) {
+        if (this != &other) {
+            reset();
+            idx = other.idx;
+            retain();
+        }
+        return *this;
+    }
+
+    DronecanMessageHandle& operator=(DronecanMessageHandle&& other) {
+        if (this != &other) {
+            reset();
+            idx = other.idx;
+            other.idx = Pool::INVALID_IDX;
+        }
+        return *this;
+    }
+
+    ~DronecanMessageHandle() {
+        reset();
+    }
+
+    /**
+     * @brief Release the message. The buffer returns to the pool if it was the last handle.
+     */
+    void reset() {
+        if (idx != Pool::INVALID_IDX) {
+            Pool::refcounts[idx]--;
+            idx = Pool::INVALID_IDX;
+        }
+    }
+
+    explicit operator bool() const {
+        return idx != Pool::INVALID_IDX;
+    }
+
+    const MessageType& operator*() const {
+        return Pool::buffers[idx];
+    }
+
+    const MessageType* operator->() const {
+        return &Pool::buffers[idx];
+    }
+
+    const MessageType* get() const {
+        return (idx != Pool::INVALID_IDX) ? &Pool::buffers[idx] : nullptr;
+    }
+
+    uint8_t getRefCount() const {
+        return (idx != Pool::INVALID_IDX) ? Pool::refcounts[idx] : 0;
+    }
+
+    /**
+     * @brief Mutable access for the producer of the message, e.g. a subscriber that deserializes into it.
+     */
+    MessageType* edit() {
+        return (idx != Pool::INVALID_IDX) ? &Pool::buffers[idx] : nullptr;
+    }
+
+private:
+    friend class DronecanMessagePool<MessageType>;
+
+    explicit DronecanMessageHandle(uint8_t idx_) : idx(idx_) {
+        retain();
+    }
+
+    void retain() {
+        if (idx != Pool::INVALID_IDX) {
+            Pool::refcounts[idx]++;
+        }
+    }
+
+    uint8_t idx{Pool::INVALID_IDX};
+};
+
+#endif  // LIBDCNODE_MESSAGE_POOL_HPP_
@@ -32,7 +32,12 @@ typedef bool                (*ParamsIsIntegerFn)(ParamIndex_t param_idx);
 typedef bool                (*ParamsIsStringFn)(ParamIndex_t param_idx);
 typedef ParamIndex_t        (*ParamsFindFn)(const uint8_t *name, uint16_t len);
 
-/* Persistence */
+/**
+ * @brief Persistence. A flash erase can take tens of milliseconds, so save and resetToDefault
+ * may only start the operation and return PARAMS_OPERATION_PENDING.
+ * The application reports the result later with uavcanParamsCompleteOperation.
+ */
+#define PARAMS_OPERATION_PENDING    INT8_MAX
 typedef int8_t              (*ParamsSaveFn)(void);
 typedef int8_t              (*ParamsResetToDefaultFn)(void);
 
@@ -9,7 +9,11 @@
 #define LIBDCNODE_PUBLISHER_HPP_
 
 #include <stdint.h>
+#include <string.h>
 #include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <type_traits>
 #include "libdcnode/dronecan.h"
 #include "libdcnode/uavcan/equipment/actuator/Status.h"
 #include "libdcnode/uavcan/equipment/ahrs/MagneticFieldStrength2.h"
@@ -32,8 +36,6 @@
 #include "libdcnode/uavcan/equipment/indication/LightsCommand.h"
 #include "libdcnode/uavcan/equipment/range_sensor/Measurement.h"
 
-extern PlatformApi platform;
-
 template <typename MessageType>
 struct DronecanPublisherTraits;
 
@@ -92,7 +94,7 @@ public:
         PUB_PERIOD_MS(static_cast<uint32_t>(1000.0f / std::clamp(frequency, 0.001f, 1000.0f))) {};
 
     inline void spinOnce() {
-        auto crnt_time_ms = platform.getTimeMs();
+        auto crnt_time_ms = uavcanPlatformGetTimeMs();
         if (crnt_time_ms < next_pub_time_ms) {
             return;
         }
@@ -106,4 +108,494 @@ private:
     uint32_t next_pub_time_ms{500};
 };
 
+
+/**
+ * @brief Deadband comparison used by DronecanOnChangePublisher.
+ * A deadband is expressed as an instance of the message itself: each field holds the largest change
+ * of the same field that is not worth a new transfer. Enum fields are compared for equality.
+ */
+template <typename MessageType>
+struct DronecanDeadbandTraits;
+
+template <typename FieldType>
+inline bool dronecanIsOutsideDeadband(FieldType prev, FieldType crnt, FieldType deadband) {
+    if constexpr (std::is_enum_v<FieldType>) {
+        return prev != crnt;
+    } else if constexpr (std::is_floating_point_v<FieldType>) {
+        if (std::isnan(prev) || std::isnan(crnt)) {
+            return std::isnan(prev) != std::isnan(crnt);
+        }
+        return std::fabs(crnt - prev) > deadband;
+    } else {
+        uint64_t diff = (crnt > prev) ? (uint64_t)crnt - (uint64_t)prev : (uint64_t)prev - (uint64_t)crnt;
+        return diff > (uint64_t)deadband;
+    }
+}
+
+#define DEADBAND_FIELD(field) dronecanIsOutsideDeadband(prev.field, crnt.field, deadband.field)
+
+#define DEFINE_DEADBAND_TRAITS(MessageType, ChangedExpression) \
+template <> \
+struct DronecanDeadbandTraits<MessageType> { \
+    static inline bool isChanged(const MessageType& prev, const MessageType& crnt, const MessageType& deadband) { \
+        return ChangedExpression; \
+    } \
+};
+
+DEFINE_DEADBAND_TRAITS(Temperature_t,
+    DEADBAND_FIELD(device_id) || DEADBAND_FIELD(temperature) || DEADBAND_FIELD(error_flags))
+DEFINE_DEADBAND_TRAITS(CircuitStatus_t,
+    DEADBAND_FIELD(circuit_id) || DEADBAND_FIELD(voltage) || DEADBAND_FIELD(current) ||
+    DEADBAND_FIELD(error_flags))
+DEFINE_DEADBAND_TRAITS(FuelTankStatus_t,
+    DEADBAND_FIELD(available_fuel_volume_percent) || DEADBAND_FIELD(available_fuel_volume_cm3) ||
+    DEADBAND_FIELD(fuel_consumption_rate_cm3pm) || DEADBAND_FIELD(fuel_temperature) ||
+    DEADBAND_FIELD(fuel_tank_id))
+DEFINE_DEADBAND_TRAITS(HardpointStatus,
+    DEADBAND_FIELD(hardpoint_id) || DEADBAND_FIELD(payload_weight) ||
+    DEADBAND_FIELD(payload_weight_variance) || DEADBAND_FIELD(status))
+DEFINE_DEADBAND_TRAITS(BatteryInfo_t,
+    DEADBAND_FIELD(temperature) || DEADBAND_FIELD(voltage) || DEADBAND_FIELD(current) ||
+    DEADBAND_FIELD(average_power_10sec) || DEADBAND_FIELD(remaining_capacity_wh) ||
+    DEADBAND_FIELD(full_charge_capacity_wh) || DEADBAND_FIELD(hours_to_full_charge) ||
+    DEADBAND_FIELD(status_flags) || DEADBAND_FIELD(state_of_health_pct) ||
+    DEADBAND_FIELD(state_of_charge_pct) || DEADBAND_FIELD(state_of_charge_pct_stdev) ||
+    DEADBAND_FIELD(battery_id) || DEADBAND_FIELD(model_instance_id))
+
+
+/**
+ * @brief Publish only when a field leaves its deadband relative to the last published message,
+ * or when the heartbeat period expires, so the worst-case age of the data on the bus is bounded.
+ * @param[in] deadband per-field thresholds, see DronecanDeadbandTraits
+ * @param[in] heartbeat_frequency the minimal publish rate when nothing changes
+ * @param[in] max_frequency the publish rate limit when a value changes faster than the deadband
+ */
+template <typename MessageType>
+class DronecanOnChangePublisher : public DronecanPublisher<MessageType> {
+public:
+    DronecanOnChangePublisher(const MessageType& deadband_, float heartbeat_frequency, float max_frequency=100.0f) :
+        DronecanPublisher<MessageType>(),
+        deadband(deadband_),
+        HEARTBEAT_PERIOD_MS(static_cast<uint32_t>(1000.0f / std::clamp(heartbeat_frequency, 0.001f, 1000.0f))),
+        MIN_PERIOD_MS(static_cast<uint32_t>(1000.0f / std::clamp(max_frequency, 0.001f, 1000.0f))) {};
+
+    inline void spinOnce() {
+        auto crnt_time_ms = uavcanPlatformGetTimeMs();
+        if (crnt_time_ms < last_pub_time_ms + MIN_PERIOD_MS && published_once) {
+            return;
+        }
+
+        bool is_heartbeat_expired = crnt_time_ms >= last_pub_time_ms + HEARTBEAT_PERIOD_MS;
+        if (published_once && !is_heartbeat_expired && !isChanged()) {
+            return;
+        }
+
+        last_pub_time_ms = crnt_time_ms;
+        last_published_msg = this->msg;
+        published_once = true;
+        this->publish();
+    }
+
+    inline bool isChanged() const {
+        return DronecanDeadbandTraits<MessageType>::isChanged(last_published_msg, this->msg, deadband);
+    }
+
+    MessageType deadband;
+
+private:
+    const uint32_t HEARTBEAT_PERIOD_MS;
+    const uint32_t MIN_PERIOD_MS;
+    uint32_t last_pub_time_ms{0};
+    bool published_once{false};
+    MessageType last_published_msg{};
+};
+
+
+/**
+ * @brief Reduction applied to the samples accumulated between two publications.
+ * Only floating point fields are reduced, other fields always keep the last sample.
+ */
+enum class DronecanReducer : uint8_t {
+    LAST,
+    MIN,
+    MAX,
+    MEAN,
+};
+
+template <typename MessageType>
+struct DronecanAggregateTraits;
+
+template <typename FieldType>
+inline void dronecanReduceField(FieldType& acc, const FieldType& sample, DronecanReducer reducer, uint32_t count) {
+    if constexpr (std::is_array_v<FieldType>) {
+        for (size_t idx = 0; idx < std::extent_v<FieldType>; idx++) {
+            dronecanReduceField(acc[idx], sample[idx], reducer, count);
+        }
+    } else if constexpr (std::is_floating_point_v<FieldType>) {
+        switch (reducer) {
+            case DronecanReducer::MIN:
+                acc = std::fmin(acc, sample);
+                break;
+            case DronecanReducer::MAX:
+                acc = std::fmax(acc, sample);
+                break;
+            case DronecanReducer::MEAN:
+                acc += (sample - acc) / static_cast<FieldType>(count);
+                break;
+            case DronecanReducer::LAST:
+            default:
+                acc = sample;
+                break;
+        }
+    } else {
+        acc = sample;
+    }
+}
+
+#define REDUCE_FIELD(field) dronecanReduceField(acc.field, sample.field, reducer, count)
+
+#define DEFINE_AGGREGATE_TRAITS(MessageType, ...) \
+template <> \
+struct DronecanAggregateTraits<MessageType> { \
+    static inline void reduce(MessageType& acc, const MessageType& sample, DronecanReducer reducer, uint32_t count) { \
+        __VA_ARGS__; \
+    } \
+};
+
+DEFINE_AGGREGATE_TRAITS(StaticPressure,
+    REDUCE_FIELD(static_pressure), REDUCE_FIELD(static_pressure_variance))
+DEFINE_AGGREGATE_TRAITS(StaticTemperature,
+    REDUCE_FIELD(static_temperature), REDUCE_FIELD(static_temperature_variance))
+DEFINE_AGGREGATE_TRAITS(IndicatedAirspeed,
+    REDUCE_FIELD(indicated_airspeed), REDUCE_FIELD(indicated_airspeed_variance))
+DEFINE_AGGREGATE_TRAITS(TrueAirspeed,
+    REDUCE_FIELD(true_airspeed), REDUCE_FIELD(true_airspeed_variance))
+DEFINE_AGGREGATE_TRAITS(RawAirData_t,
+    REDUCE_FIELD(flag), REDUCE_FIELD(static_pressure), REDUCE_FIELD(differential_pressure),
+    REDUCE_FIELD(static_pressure_sensor_temperature), REDUCE_FIELD(differential_pressure_sensor_temperature),
+    REDUCE_FIELD(static_air_temperature), REDUCE_FIELD(pitot_temperature))
+DEFINE_AGGREGATE_TRAITS(MagneticFieldStrength2,
+    REDUCE_FIELD(sensor_id), REDUCE_FIELD(magnetic_field_ga))
+DEFINE_AGGREGATE_TRAITS(RangeSensorMeasurement_t,
+    REDUCE_FIELD(timestamp), REDUCE_FIELD(sensor_id), REDUCE_FIELD(beam_orientation_in_body_frame),
+    REDUCE_FIELD(field_of_view), REDUCE_FIELD(sensor_type), REDUCE_FIELD(reading_type), REDUCE_FIELD(range))
+
+
+/**
+ * @brief Accept samples at any rate with push() and publish their reduction with a fixed rate.
+ * Nothing is published if no sample has been pushed since the previous publication.
+ */
+template <typename MessageType>
+class DronecanAggregatingPublisher : public DronecanPublisher<MessageType> {
+public:
+    DronecanAggregatingPublisher(float frequency, DronecanReducer reducer_=DronecanReducer::MEAN) :
+        DronecanPublisher<MessageType>(),
+        reducer(reducer_),
+        PUB_PERIOD_MS(static_cast<uint32_t>(1000.0f / std::clamp(frequency, 0.001f, 1000.0f))) {};
+
+    inline void push(const MessageType& sample) {
+        number_of_samples++;
+        if (number_of_samples == 1) {
+            this->msg = sample;
+        } else {
+            DronecanAggregateTraits<MessageType>::reduce(this->msg, sample, reducer, number_of_samples);
+        }
+    }
+
+    inline void spinOnce() {
+        auto crnt_time_ms = uavcanPlatformGetTimeMs();
+        if (crnt_time_ms < next_pub_time_ms || number_of_samples == 0) {
+            return;
+        }
+        next_pub_time_ms = crnt_time_ms + PUB_PERIOD_MS;
+
+        this->publish();
+        number_of_samples = 0;
+    }
+
+    inline uint32_t getNumberOfSamples() const {
+        return number_of_samples;
+    }
+
+    DronecanReducer reducer;
+
+private:
+    const uint32_t PUB_PERIOD_MS;
+    uint32_t next_pub_time_ms{0};
+    uint32_t number_of_samples{0};
+};
+
+
+/**
+ * @brief Publisher that can be updated from an ISR or another thread without tearing the message.
+ * A producer writes the whole message into the inactive buffer and commits it with a single store of
+ * the sequence number. The publish path copies the latest committed buffer and validates the copy
+ * with the sequence numbers, so the producer is never blocked.
+ * @note Only one producer per publisher is supported.
+ */
+template <typename MessageType>
+class DronecanSnapshotPublisher {
+public:
+    DronecanSnapshotPublisher() = default;
+
+    /**
+     * @brief Producer side. Can be called from an ISR or a thread other than the publishing one.
+     */
+    inline void commit(const MessageType& new_msg) {
+        uint32_t seq = committed_seq.load(std::memory_order_relaxed) + 1;
+        writing_seq.store(seq, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        buffers[seq & 1U] = new_msg;
+        committed_seq.store(seq, std::memory_order_release);
+    }
+
+    /**
+     * @brief Consumer side. Copy the latest committed message.
+     * @return false if the producer has overwritten the buffer several times during the copy
+     */
+    inline bool snapshot(MessageType* out) const {
+        for (uint8_t attempt = 0; attempt < MAX_SNAPSHOT_ATTEMPTS; attempt++) {
+            uint32_t seq = committed_seq.load(std::memory_order_acquire);
+            *out = buffers[seq & 1U];
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (writing_seq.load(std::memory_order_relaxed) - seq < 2) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Publish a consistent snapshot of the latest committed message.
+     * @return false if nothing has been committed yet or a consistent snapshot can't be taken
+     */
+    inline bool publish() {
+        if (committed_seq.load(std::memory_order_acquire) == 0 || !snapshot(&msg)) {
+            return false;
+        }
+        DronecanPublisherTraits<MessageType>::publish_once(msg, &inout_transfer_id);
+        return true;
+    }
+
+private:
+    static constexpr uint8_t MAX_SNAPSHOT_ATTEMPTS = 4;
+
+    MessageType buffers[2]{};
+    std::atomic<uint32_t> committed_seq{0};
+    std::atomic<uint32_t> writing_seq{0};
+
+    MessageType msg{};
+    uint8_t inout_transfer_id{0};
+};
+
+
+/**
+ * @brief Publish many instances of one message type, e.g. Temperature of several devices.
+ * The instances are stored in a compact array keyed by a device id. Each spinOnce publishes at most
+ * one instance in the round-robin order, so the whole pool never exceeds the total rate budget.
+ * All instances share one transfer ID because they have the same transfer descriptor.
+ */
+template <typename MessageType, uint8_t MAX_INSTANCES>
+class DronecanPublisherPool {
+public:
+    DronecanPublisherPool(float total_frequency) :
+        PUB_PERIOD_MS(static_cast<uint32_t>(1000.0f / std::clamp(total_frequency, 0.001f, 1000.0f))) {};
+
+    /**
+     * @return the message of the instance with the given key, a new instance is added if necessary,
+     * or nullptr if the pool is full
+     */
+    inline MessageType* add(uint16_t key) {
+        MessageType* msg = get(key);
+        if (msg != nullptr || size >= MAX_INSTANCES) {
+            return msg;
+        }
+        keys[size] = key;
+        msgs[size] = {};
+        return &msgs[size++];
+    }
+
+    /**
+     * @return the message of the instance with the given key or nullptr if there is no such instance
+     */
+    inline MessageType* get(uint16_t key) {
+        for (uint8_t idx = 0; idx < size; idx++) {
+            if (keys[idx] == key) {
+                return &msgs[idx];
+            }
+        }
+        return nullptr;
+    }
+
+    inline uint8_t getSize() const {
+        return size;
+    }
+
+    inline void spinOnce() {
+        auto crnt_time_ms = uavcanPlatformGetTimeMs();
+        if (crnt_time_ms < next_pub_time_ms || size == 0) {
+            return;
+        }
+        next_pub_time_ms = crnt_time_ms + PUB_PERIOD_MS;
+
+        if (next_idx >= size) {
+            next_idx = 0;
+        }
+        DronecanPublisherTraits<MessageType>::publish_once(msgs[next_idx], &inout_transfer_id);
+        next_idx++;
+    }
+
+private:
+    MessageType msgs[MAX_INSTANCES]{};
+    uint16_t keys[MAX_INSTANCES]{};
+    uint8_t size{0};
+    uint8_t next_idx{0};
+    uint8_t inout_transfer_id{0};
+
+    const uint32_t PUB_PERIOD_MS;
+    uint32_t next_pub_time_ms{0};
+};
+
+
+/**
+ * @brief Field layout used by DronecanIncrementalPublisher.
+ * FIELDS[i] is the range of the struct members that are serialized by the field i.
+ */
+struct DronecanFieldRange {
+    size_t offset;
+    size_t size;
+};
+
+template <typename MessageType>
+struct DronecanIncrementalTraits;
+
+#define FIELD_RANGE(MessageType, first_member, last_member) \
+    {offsetof(MessageType, first_member), \
+     offsetof(MessageType, last_member) + sizeof(MessageType::last_member) - offsetof(MessageType, first_member)}
+
+template <>
+struct DronecanIncrementalTraits<GnssFix2> {
+    static constexpr uint64_t SIGNATURE = UAVCAN_EQUIPMENT_GNSS_FIX2_SIGNATURE;
+    static constexpr uint16_t ID = UAVCAN_EQUIPMENT_GNSS_FIX2_ID;
+    static constexpr size_t MAX_SIZE = UAVCAN_EQUIPMENT_GNSS_FIX2_MESSAGE_SIZE;
+    static constexpr uint8_t NUMBER_OF_FIELDS = GNSS_FIX2_NUMBER_OF_FIELDS;
+    static constexpr DronecanFieldRange FIELDS[NUMBER_OF_FIELDS] = {
+        FIELD_RANGE(GnssFix2, timestamp, timestamp),
+        FIELD_RANGE(GnssFix2, gnss_timestamp, gnss_timestamp),
+        FIELD_RANGE(GnssFix2, gnss_time_standard, gnss_time_standard),
+        FIELD_RANGE(GnssFix2, num_leap_seconds, num_leap_seconds),
+        FIELD_RANGE(GnssFix2, longitude_deg_1e8, longitude_deg_1e8),
+        FIELD_RANGE(GnssFix2, latitude_deg_1e8, latitude_deg_1e8),
+        FIELD_RANGE(GnssFix2, height_ellipsoid_mm, height_ellipsoid_mm),
+        FIELD_RANGE(GnssFix2, height_msl_mm, height_msl_mm),
+        FIELD_RANGE(GnssFix2, ned_velocity, ned_velocity),
+        FIELD_RANGE(GnssFix2, sats_used, sats_used),
+        FIELD_RANGE(GnssFix2, status, status),
+        FIELD_RANGE(GnssFix2, mode, mode),
+        FIELD_RANGE(GnssFix2, sub_mode, sub_mode),
+        FIELD_RANGE(GnssFix2, covariance_len, covariance),
+        FIELD_RANGE(GnssFix2, pdop, pdop),
+        FIELD_RANGE(GnssFix2, ecef_size, ecef),
+    };
+    static inline void serialize_field(const GnssFix2& msg, uint8_t* buffer, uint8_t field) {
+        dronecan_equipment_gnss_fix2_serialize_field(&msg, buffer, (GnssFix2Field)field);
+    }
+    static inline uint16_t get_payload_len(const GnssFix2& msg) {
+        return (dronecan_equipment_gnss_fix2_get_bit_length(&msg) + 7) / 8;
+    }
+};
+
+template <>
+struct DronecanIncrementalTraits<AhrsSolution_t> {
+    static constexpr uint64_t SIGNATURE = UAVCAN_EQUIPMENT_AHRS_SOLUTION_SIGNATURE;
+    static constexpr uint16_t ID = UAVCAN_EQUIPMENT_AHRS_SOLUTION_ID;
+    static constexpr size_t MAX_SIZE = UAVCAN_EQUIPMENT_AHRS_SOLUTION_MESSAGE_SIZE;
+    static constexpr uint8_t NUMBER_OF_FIELDS = AHRS_SOLUTION_NUMBER_OF_FIELDS;
+    static constexpr DronecanFieldRange FIELDS[NUMBER_OF_FIELDS] = {
+        FIELD_RANGE(AhrsSolution_t, timestamp, timestamp),
+        FIELD_RANGE(AhrsSolution_t, orientation_xyzw, orientation_xyzw),
+        FIELD_RANGE(AhrsSolution_t, angular_velocity, angular_velocity),
+        FIELD_RANGE(AhrsSolution_t, linear_acceleration, linear_acceleration),
+    };
+    static inline void serialize_field(const AhrsSolution_t& msg, uint8_t* buffer, uint8_t field) {
+        dronecan_equipment_ahrs_solution_serialize_field(&msg, buffer, (AhrsSolutionField)field);
+    }
+    static inline uint16_t get_payload_len(const AhrsSolution_t&) {
+        return UAVCAN_EQUIPMENT_AHRS_SOLUTION_MESSAGE_SIZE;
+    }
+};
+
+
+/**
+ * @brief Publisher that keeps the serialized image of the message between publications.
+ * The message is modified with set() or markDirty(), which mark the affected fields as dirty,
+ * and publish() re-encodes only the bit ranges of the dirty fields.
+ */
+template <typename MessageType>
+class DronecanIncrementalPublisher {
+    using Traits = DronecanIncrementalTraits<MessageType>;
+    static_assert(Traits::NUMBER_OF_FIELDS <= 32, "Dirty mask is limited by 32 fields");
+
+public:
+    DronecanIncrementalPublisher() = default;
+
+    /**
+     * @brief Assign a member of the message. The field is marked as dirty only if the value differs.
+     * Usage example: fix2_pub.set(&GnssFix2::latitude_deg_1e8, latitude);
+     */
+    template <typename FieldType>
+    inline void set(FieldType MessageType::* member, const FieldType& value) {
+        FieldType& dst = msg.*member;
+        if (memcmp(&dst, &value, sizeof(FieldType)) == 0) {
+            return;
+        }
+        memcpy(&dst, &value, sizeof(FieldType));
+        markDirty(member);
+    }
+
+    /**
+     * @brief Use it after modifying a member in place with edit(), e.g. a single covariance element.
+     */
+    template <typename FieldType>
+    inline void markDirty(FieldType MessageType::* member) {
+        const size_t offset = reinterpret_cast<const uint8_t*>(&(msg.*member)) - reinterpret_cast<const uint8_t*>(&msg);
+        for (uint8_t field = 0; field < Traits::NUMBER_OF_FIELDS; field++) {
+            if (offset >= Traits::FIELDS[field].offset &&
+                    offset < Traits::FIELDS[field].offset + Traits::FIELDS[field].size) {
+                dirty_mask |= 1UL << field;
+                return;
+            }
+        }
+    }
+
+    inline MessageType& edit() {
+        return msg;
+    }
+
+    inline const MessageType& get() const {
+        return msg;
+    }
+
+    inline int16_t publish() {
+        for (uint8_t field = 0; dirty_mask != 0; field++, dirty_mask >>= 1) {
+            if (dirty_mask & 1UL) {
+                Traits::serialize_field(msg, image, field);
+            }
+        }
+
+        return uavcanPublish(Traits::SIGNATURE,
+                             Traits::ID,
+                             &inout_transfer_id,
+                             CANARD_TRANSFER_PRIORITY_MEDIUM,
+                             image,
+                             Traits::get_payload_len(msg));
+    }
+
+private:
+    MessageType msg{};
+    uint8_t image[Traits::MAX_SIZE]{};
+    uint32_t dirty_mask{(Traits::NUMBER_OF_FIELDS < 32) ? (1UL << Traits::NUMBER_OF_FIELDS) - 1 : 0xFFFFFFFF};
+    uint8_t inout_transfer_id{0};
+};
+
 #endif  // LIBDCNODE_PUBLISHER_HPP_
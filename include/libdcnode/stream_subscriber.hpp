@@ -0,0 +1,270 @@
+/*
+ * Copyright (C) 2025 Dmitry Ponomarev <ponomarevda96@gmail.com>
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef LIBDCNODE_STREAM_SUBSCRIBER_HPP_
+#define LIBDCNODE_STREAM_SUBSCRIBER_HPP_
+
+#include <stdint.h>
+#include <algorithm>
+#include <array>
+#include "libdcnode/dronecan.h"
+#include "libdcnode/delegate.hpp"
+#include "libdcnode/uavcan/equipment/gnss/Fix2.h"
+
+/**
+ * @brief Keep the last bytes of a streamed payload and read bit fields from them in order.
+ * Only the bytes of the fields that are not decoded yet are kept.
+ */
+class DronecanStreamReader {
+public:
+    static constexpr uint8_t WINDOW_SIZE = 32;
+
+    inline void reset() {
+        received_bytes = 0;
+        cursor = 0;
+        is_overflowed = false;
+    }
+
+    inline void push(const uint8_t* data, uint8_t len) {
+        if (received_bytes + len - cursor / 8 > WINDOW_SIZE) {
+            is_overflowed = true;
+            return;
+        }
+        for (uint8_t idx = 0; idx < len; idx++) {
+            window[(received_bytes++) % WINDOW_SIZE] = data[idx];
+        }
+    }
+
+    /**
+     * @brief Decode the next field in the same way as canardDecodeScalar does
+     * @return false if the field hasn't been received completely yet
+     */
+    inline bool read(uint8_t bit_length, bool is_signed, void* out) {
+        if (getAvailableBits() < bit_length) {
+            return false;
+        }
+
+        uint8_t bytes[9];
+        const uint32_t first_byte = cursor / 8;
+        const uint8_t number_of_bytes = (uint8_t)(((cursor % 8) + bit_length + 7) / 8);
+        for (uint8_t idx = 0; idx < number_of_bytes; idx++) {
+            bytes[idx] = window[(first_byte + idx) % WINDOW_SIZE];
+        }
+
+        CanardRxTransfer transfer{};
+        transfer.payload_head = bytes;
+        transfer.payload_len = number_of_bytes;
+        canardDecodeScalar(&transfer, cursor % 8, bit_length, is_signed, out);
+        cursor += bit_length;
+        return true;
+    }
+
+    inline bool readFloat16(float* out) {
+        uint16_t f16;
+        if (!read(16, false, &f16)) {
+            return false;
+        }
+        *out = canardConvertFloat16ToNativeFloat(f16);
+        return true;
+    }
+
+    inline uint32_t getAvailableBits() const {
+        return received_bytes * 8 - cursor;
+    }
+
+    inline uint32_t getCursor() const {
+        return cursor;
+    }
+
+    inline bool isOverflowed() const {
+        return is_overflowed;
+    }
+
+private:
+    uint8_t window[WINDOW_SIZE];
+    uint32_t received_bytes{0};
+    uint32_t cursor{0};
+    bool is_overflowed{false};
+};
+
+template <typename MessageType>
+class DronecanStreamDecoder;
+
+/**
+ * @brief uavcan.equipment.gnss.Fix2 decoder that decodes the fields as their bytes arrive.
+ * The optional ECEF part is present if the payload is long enough to contain it.
+ */
+template <>
+class DronecanStreamDecoder<GnssFix2> {
+public:
+    static constexpr uint64_t SIGNATURE = UAVCAN_EQUIPMENT_GNSS_FIX2_SIGNATURE;
+    static constexpr uint16_t ID = UAVCAN_EQUIPMENT_GNSS_FIX2_ID;
+
+    inline void reset() {
+        reader.reset();
+        msg = {};
+        step = 0;
+        idx = 0;
+    }
+
+    inline void feed(const uint8_t* data, uint8_t len) {
+        reader.push(data, len);
+        while (step < DONE && decodeNext()) {
+        }
+    }
+
+    /**
+     * @return true if the payload contained a complete message
+     */
+    inline bool finish() {
+        msg.ecef_size = (step == DONE) ? 1 : 0;
+        return !reader.isOverflowed() && step >= ECEF_VELOCITY;
+    }
+
+    GnssFix2 msg{};
+
+private:
+    enum Step : uint8_t {
+        TIMESTAMP, GNSS_TIMESTAMP, GNSS_TIME_STANDARD, VOID13, NUM_LEAP_SECONDS,
+        LONGITUDE, LATITUDE, HEIGHT_ELLIPSOID, HEIGHT_MSL, NED_VELOCITY, SATS_USED, STATUS, MODE, SUB_MODE,
+        COVARIANCE_LEN, COVARIANCE, PDOP,
+        ECEF_VELOCITY, ECEF_POSITION, ECEF_TAIL,
+        DONE,
+    };
+
+    inline bool next(bool is_decoded) {
+        if (is_decoded) {
+            step++;
+            idx = 0;
+        }
+        return is_decoded;
+    }
+
+    inline bool nextElement(bool is_decoded, uint8_t size) {
+        if (is_decoded && ++idx >= size) {
+            step++;
+            idx = 0;
+        }
+        return is_decoded;
+    }
+
+    inline bool decodeNext() {
+        uint32_t dummy = 0;
+        switch (step) {
+            case TIMESTAMP:
+                return next(reader.read(56, false, &msg.timestamp));
+            case GNSS_TIMESTAMP:
+                return next(reader.read(56, false, &msg.gnss_timestamp));
+            case GNSS_TIME_STANDARD:
+                return next(reader.read(3, false, &msg.gnss_time_standard));
+            case VOID13:
+                return next(reader.read(13, false, &dummy));
+            case NUM_LEAP_SECONDS:
+                return next(reader.read(8, false, &msg.num_leap_seconds));
+            case LONGITUDE:
+                return next(reader.read(37, true, &msg.longitude_deg_1e8));
+            case LATITUDE:
+                return next(reader.read(37, true, &msg.latitude_deg_1e8));
+            case HEIGHT_ELLIPSOID:
+                return next(reader.read(27, true, &msg.height_ellipsoid_mm));
+            case HEIGHT_MSL:
+                return next(reader.read(27, true, &msg.height_msl_mm));
+            case NED_VELOCITY:
+                return nextElement(reader.read(32, false, &msg.ned_velocity[idx]), 3);
+            case SATS_USED:
+                return next(reader.read(6, false, &msg.sats_used));
+            case STATUS:
+                if (!reader.read(2, false, &dummy)) {
+                    return false;
+                }
+                msg.status = (GnssFix2_status)dummy;
+                return next(true);
+            case MODE:
+                return next(reader.read(4, false, &msg.mode));
+            case SUB_MODE:
+                return next(reader.read(6, false, &msg.sub_mode));
+            case COVARIANCE_LEN:
+                if (!reader.read(6, false, &msg.covariance_len)) {
+                    return false;
+                }
+                msg.covariance_len = std::min<uint8_t>(msg.covariance_len, 36);
+                step = (msg.covariance_len == 0) ? PDOP : COVARIANCE;
+                return true;
+            case COVARIANCE:
+                return nextElement(reader.readFloat16(&msg.covariance[idx]), msg.covariance_len);
+            case PDOP:
+                return next(reader.readFloat16(&msg.pdop));
+            case ECEF_VELOCITY:
+                return nextElement(reader.read(32, false, &msg.ecef.velocity_xyz[idx]), 3);
+            case ECEF_POSITION:
+                return nextElement(reader.read(36, true, &msg.ecef.position_xyz_mm[idx]), 3);
+            case ECEF_TAIL:
+                return next(reader.read(12, false, &dummy));
+            default:
+                return false;
+        }
+    }
+
+    DronecanStreamReader reader;
+    uint8_t step{0};
+    uint8_t idx{0};
+};
+
+/**
+ * @brief Subscriber that decodes a multi-frame message while its frames arrive.
+ * The callback is called after the last frame only if the CRC matches, so it receives the message
+ * with a minimal delay and the transfer doesn't occupy the libcanard memory pool.
+ */
+template <typename MessageType>
+class DronecanStreamingSubscriber {
+public:
+    using Decoder = DronecanStreamDecoder<MessageType>;
+
+    DronecanStreamingSubscriber() = default;
+
+    int8_t init(DronecanDelegate<void(const MessageType&)> callback) {
+        user_callback = callback;
+        sub_id = uavcanSubscribeStream(Decoder::SIGNATURE, Decoder::ID, &CALLBACKS);
+        if (sub_id >= 0) {
+            instances[sub_id] = this;
+        }
+        return sub_id;
+    }
+
+    uint32_t getNumberOfDiscarded() const {
+        return discarded;
+    }
+
+    static inline std::array<DronecanStreamingSubscriber*, DRONECAN_MAX_STREAM_SUBS_NUMBER> instances{};
+
+private:
+    static inline void onStart(const CanardRxTransfer* transfer) {
+        instances[transfer->sub_id]->decoder.reset();
+    }
+
+    static inline void onBytes(const CanardRxTransfer* transfer, const uint8_t* data, uint8_t len) {
+        instances[transfer->sub_id]->decoder.feed(data, len);
+    }
+
+    static inline void onEnd(CanardRxTransfer* transfer, bool is_valid) {
+        auto instance = instances[transfer->sub_id];
+        if (!instance->decoder.finish() || !is_valid) {
+            instance->discarded++;
+            return;
+        }
+        instance->user_callback(instance->decoder.msg);
+    }
+
+    static constexpr UavcanStreamCallbacks CALLBACKS = {&onStart, &onBytes, &onEnd};
+
+    Decoder decoder;
+    DronecanDelegate<void(const MessageType&)> user_callback;
+    int8_t sub_id{-1};
+    uint32_t discarded{0};
+};
+
+#endif  // LIBDCNODE_STREAM_SUBSCRIBER_HPP_
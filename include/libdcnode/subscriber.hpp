@@ -9,9 +9,14 @@
 #define LIBDCNODE_SUBSCRIBER_HPP_
 
 #include <stdint.h>
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include "libdcnode/dronecan.h"
+#include "libdcnode/delegate.hpp"
+#include "libdcnode/message_pool.hpp"
 #include "libdcnode/uavcan/equipment/esc/RawCommand.h"
+#include "libdcnode/uavcan/equipment/esc/Status.h"
 #include "libdcnode/uavcan/equipment/actuator/ArrayCommand.h"
 #include "libdcnode/uavcan/equipment/indication/BeepCommand.h"
 #include "libdcnode/uavcan/equipment/indication/LightsCommand.h"
@@ -55,42 +60,916 @@ DEFINE_SUBSCRIBER_TRAITS(HardpointCommand,
 DEFINE_SUBSCRIBER_TRAITS(AhrsSolution_t,
                          uavcanSubscribeAhrsSolution,
                          dronecan_equipment_ahrs_solution_deserialize)
+DEFINE_SUBSCRIBER_TRAITS(EscStatus_t,
+                         uavcanSubscribeEscStatus,
+                         dronecan_equipment_esc_status_deserialize)
+
+/**
+ * @brief Single-frame capable types that can be dispatched from the CAN RX interrupt
+ */
+template <typename MessageType>
+struct DronecanFastSubscriberTraits;
+
+#define DEFINE_FAST_SUBSCRIBER_TRAITS(MessageType, DataType) \
+template <> \
+struct DronecanFastSubscriberTraits<MessageType> { \
+    static inline int8_t subscribe(void (*callback)(CanardRxTransfer*)) { \
+        return uavcanSubscribeFast(DataType, callback); \
+    } \
+};
+
+DEFINE_FAST_SUBSCRIBER_TRAITS(RawCommand_t,         UAVCAN_EQUIPMENT_ESC_RAWCOMMAND)
+DEFINE_FAST_SUBSCRIBER_TRAITS(ArrayCommand_t,       UAVCAN_EQUIPMENT_ACTUATOR_ARRAY_COMMAND)
+DEFINE_FAST_SUBSCRIBER_TRAITS(BeepCommand_t,        UAVCAN_EQUIPMENT_INDICATION_BEEPCOMMAND)
+DEFINE_FAST_SUBSCRIBER_TRAITS(LightsCommand_t,      UAVCAN_EQUIPMENT_INDICATION_LIGHTS_COMMAND)
+DEFINE_FAST_SUBSCRIBER_TRAITS(SafetyArmingStatus,   UAVCAN_EQUIPMENT_SAFETY_ARMING_STATUS)
+DEFINE_FAST_SUBSCRIBER_TRAITS(HardpointCommand,     UAVCAN_EQUIPMENT_HARDPOINT_COMMAND)
+
+template <>
+struct DronecanSubscriberTraits<NodeStatus_t> {
+    static inline int8_t subscribe(void (*callback)(CanardRxTransfer*)) {
+        return uavcanSubscribe(UAVCAN_PROTOCOL_NODE_STATUS, callback);
+    }
+    static inline int8_t deserialize(CanardRxTransfer* transfer, NodeStatus_t* msg) {
+        return uavcanDecodeNodeStatus(transfer, msg);
+    }
+};
+
+/**
+ * @brief Read a byte of the raw payload without deserialization.
+ * Single-frame payloads and the head of multi-frame payloads are read directly.
+ * A multi-frame payload may end in the middle blocks, so only a transfer without both the middle
+ * blocks and the tail is single-frame.
+ */
+static inline uint8_t dronecanGetRawPayloadByte(const CanardRxTransfer* transfer, uint16_t byte_idx) {
+    bool is_single_frame = transfer->payload_middle == nullptr && transfer->payload_tail == nullptr;
+    if (is_single_frame || byte_idx < CANARD_MULTIFRAME_RX_PAYLOAD_HEAD_SIZE) {
+        return transfer->payload_head[byte_idx];
+    }
+    uint8_t value = 0;
+    canardDecodeScalar(transfer, byte_idx * 8U, 8, false, &value);
+    return value;
+}
+
+/**
+ * @brief Cheap predicate that runs on the raw transfer before deserialization.
+ * A default constructed filter accepts everything. The conditions are combined with AND.
+ */
+class DronecanRawFilter {
+public:
+    DronecanRawFilter() = default;
+
+    /**
+     * @brief Accept only transfers that have a byte equal to value at first_byte + k * stride.
+     * Zero stride checks only first_byte.
+     */
+    static DronecanRawFilter byteAtStride(uint16_t first_byte, uint8_t stride, uint8_t value) {
+        DronecanRawFilter filter;
+        filter.byte_rule_enabled = true;
+        filter.first_byte = first_byte;
+        filter.stride = stride;
+        filter.value = value;
+        return filter;
+    }
+
+    static DronecanRawFilter byteEquals(uint16_t byte_idx, uint8_t value) {
+        return byteAtStride(byte_idx, 0, value);
+    }
+
+    /**
+     * @brief uavcan.equipment.actuator.ArrayCommand that has a command for the given actuator
+     */
+    static DronecanRawFilter arrayCommandActuatorId(uint8_t actuator_id) {
+        return byteAtStride(0, UAVCAN_EQUIPMENT_ACTUATOR_COMMAND_MESSAGE_SIZE, actuator_id);
+    }
+
+    static DronecanRawFilter sourceNode(uint8_t node_id) {
+        return DronecanRawFilter().allowSourceNode(node_id);
+    }
+
+    static DronecanRawFilter custom(bool (*predicate)(const CanardRxTransfer*)) {
+        DronecanRawFilter filter;
+        filter.custom_predicate = predicate;
+        return filter;
+    }
+
+    /**
+     * @brief Add a node to the set of allowed source nodes. Initially all source nodes are allowed.
+     */
+    DronecanRawFilter& allowSourceNode(uint8_t node_id) {
+        if (!source_rule_enabled) {
+            source_rule_enabled = true;
+            source_node_mask = {};
+        }
+        source_node_mask[(node_id & 127U) >> 5U] |= 1UL << (node_id & 31U);
+        return *this;
+    }
+
+    inline bool match(const CanardRxTransfer* transfer) const {
+        if (source_rule_enabled) {
+            uint8_t node_id = transfer->source_node_id & 127U;
+            if ((source_node_mask[node_id >> 5U] & (1UL << (node_id & 31U))) == 0) {
+                return false;
+            }
+        }
+
+        if (byte_rule_enabled && !matchByteRule(transfer)) {
+            return false;
+        }
+
+        return custom_predicate == nullptr || custom_predicate(transfer);
+    }
+
+private:
+    inline bool matchByteRule(const CanardRxTransfer* transfer) const {
+        for (uint16_t idx = first_byte; idx < transfer->payload_len; idx += stride) {
+            if (dronecanGetRawPayloadByte(transfer, idx) == value) {
+                return true;
+            }
+            if (stride == 0) {
+                break;
+            }
+        }
+        return false;
+    }
+
+    bool source_rule_enabled{false};
+    std::array<uint32_t, 4> source_node_mask{};
+
+    bool byte_rule_enabled{false};
+    uint8_t stride{0};
+    uint8_t value{0};
+    uint16_t first_byte{0};
+
+    bool (*custom_predicate)(const CanardRxTransfer*){nullptr};
+};
+
+/**
+ * @brief Common part of all subscribers: a handle of the subscription in the node
+ */
+class DronecanSubscription {
+public:
+    /**
+     * @brief Remove the subscription. The subscriber can be initialized again later.
+     */
+    inline int8_t unsubscribe() {
+        int8_t res = uavcanUnsubscribe(sub_id);
+        if (instance_slot != nullptr) {
+            *instance_slot = nullptr;
+            instance_slot = nullptr;
+        }
+        sub_id = -1;
+        return res;
+    }
+
+    /**
+     * @brief Pause and resume the subscription without losing its configuration
+     */
+    inline int8_t enable() {
+        return uavcanEnableSubscription(sub_id);
+    }
+    inline int8_t disable() {
+        return uavcanDisableSubscription(sub_id);
+    }
+    inline bool isEnabled() const {
+        return uavcanIsSubscriptionEnabled(sub_id);
+    }
+
+    inline int8_t getSubId() const {
+        return sub_id;
+    }
+
+protected:
+    /**
+     * @brief Make the subscriber reachable from its static transfer callback until it unsubscribes
+     */
+    inline void registerInstance(std::array<void*, DRONECAN_MAX_SUBS_NUMBER>& instances, void* instance) {
+        instance_slot = &instances[sub_id];
+        *instance_slot = instance;
+    }
+
+    int8_t sub_id{-1};
+
+private:
+    void** instance_slot{nullptr};
+};
 
 template <typename MessageType>
-class DronecanSubscriber {
+class DronecanSubscriber : public DronecanSubscription {
 public:
+    using Callback = DronecanDelegate<void(const MessageType&)>;
+    using Filter = DronecanDelegate<bool(const MessageType&)>;
+
     DronecanSubscriber() = default;
 
-    int8_t init(void (*callback)(const MessageType&), bool (*filter_)(const MessageType&)=nullptr) {
+    /**
+     * @param[in] callback is a function, a small lambda or Callback::bind<&Class::method>(object)
+     * @param[in] filter is called after deserialization
+     * @param[in] raw_filter_ is checked before deserialization, so rejected transfers are cheap
+     */
+    int8_t init(Callback callback,
+                Filter filter_=nullptr,
+                const DronecanRawFilter& raw_filter_=DronecanRawFilter()) {
         user_callback = callback;
         filter = filter_;
-        auto sub_id = DronecanSubscriberTraits<MessageType>::subscribe(transfer_callback);
-        instances[sub_id] = this;
+        raw_filter = raw_filter_;
+        sub_id = DronecanSubscriberTraits<MessageType>::subscribe(transfer_callback);
+        if (sub_id >= 0) {
+            registerInstance(instances, this);
+        }
         return sub_id;
     }
 
     static inline void transfer_callback(CanardRxTransfer* transfer) {
-        int8_t res = DronecanSubscriberTraits<MessageType>::deserialize(transfer, &msg);
+        auto instance = static_cast<DronecanSubscriber*>(instances[transfer->sub_id]);
+        if (instance == nullptr || !instance->raw_filter.match(transfer)) {
+            return;
+        }
+
+        int8_t res = DronecanSubscriberTraits<MessageType>::deserialize(transfer, &instance->msg);
         if (res < 0) {
             return;
         }
 
-        auto instance = static_cast<DronecanSubscriber*>(instances[transfer->sub_id]);
+        if (instance->filter && !instance->filter(instance->msg)) {
+            return;
+        }
+
+        instance->user_callback(instance->msg);
+    }
+
+    static inline std::array<void*, DRONECAN_MAX_SUBS_NUMBER> instances{};
+    MessageType msg = {};
+    Callback user_callback;
+    Filter filter;
+    DronecanRawFilter raw_filter;
+};
+
+/**
+ * @brief Subscriber dispatched from the CAN RX interrupt, see uavcanSubscribeFast.
+ * Single-frame transfers, e.g. RawCommand with up to 4 channels, are decoded on the interrupt stack
+ * and the callback runs in the interrupt context, so it should be short and must not call the node API.
+ * Multi-frame transfers reach the same callback from uavcanSpinOnce.
+ */
+template <typename MessageType>
+class DronecanFastSubscriber {
+public:
+    DronecanFastSubscriber() = default;
+
+    int8_t init(DronecanDelegate<void(const MessageType&)> callback) {
+        user_callback = callback;
+        fast_sub_id = DronecanFastSubscriberTraits<MessageType>::subscribe(transfer_callback);
+        if (fast_sub_id >= 0) {
+            instances[fast_sub_id] = this;
+        }
+        return fast_sub_id;
+    }
+
+    static inline void transfer_callback(CanardRxTransfer* transfer) {
+        auto instance = static_cast<DronecanFastSubscriber*>(instances[transfer->sub_id]);
         if (instance == nullptr) {
             return;
         }
 
-        if (instance->filter != nullptr && !instance->filter(msg)) {
+        MessageType msg = {};
+        if (DronecanSubscriberTraits<MessageType>::deserialize(transfer, &msg) < 0) {
             return;
         }
 
         instance->user_callback(msg);
     }
 
+    static inline std::array<void*, DRONECAN_MAX_FAST_SUBS_NUMBER> instances{};
+    DronecanDelegate<void(const MessageType&)> user_callback;
+    int8_t fast_sub_id{-1};
+};
+
+/**
+ * @brief Subscriber that deserializes each message into a buffer of DronecanMessagePool.
+ * The callback receives a handle that can be kept or passed to other modules without copying.
+ * A message is dropped if all buffers of the pool are still referenced.
+ */
+template <typename MessageType>
+class DronecanPooledSubscriber : public DronecanSubscription {
+public:
+    using Handle = DronecanMessageHandle<MessageType>;
+
+    DronecanPooledSubscriber() = default;
+
+    int8_t init(DronecanDelegate<void(const Handle&)> callback,
+                const DronecanRawFilter& raw_filter_=DronecanRawFilter()) {
+        user_callback = callback;
+        raw_filter = raw_filter_;
+        sub_id = DronecanSubscriberTraits<MessageType>::subscribe(transfer_callback);
+        if (sub_id >= 0) {
+            registerInstance(instances, this);
+        }
+        return sub_id;
+    }
+
+    static inline void transfer_callback(CanardRxTransfer* transfer) {
+        auto instance = static_cast<DronecanPooledSubscriber*>(instances[transfer->sub_id]);
+        if (instance == nullptr || !instance->raw_filter.match(transfer)) {
+            return;
+        }
+
+        Handle handle = DronecanMessagePool<MessageType>::allocate();
+        if (!handle) {
+            instance->dropped++;
+            return;
+        }
+
+        int8_t res = DronecanSubscriberTraits<MessageType>::deserialize(transfer, handle.edit());
+        if (res < 0) {
+            return;
+        }
+
+        instance->user_callback(handle);
+    }
+
+    uint32_t getNumberOfDropped() const {
+        return dropped;
+    }
+
+    static inline std::array<void*, DRONECAN_MAX_SUBS_NUMBER> instances{};
+    DronecanDelegate<void(const Handle&)> user_callback;
+    DronecanRawFilter raw_filter;
+    uint32_t dropped{0};
+};
+
+enum class DronecanQueuePolicy : uint8_t {
+    DROP_OLDEST,    ///< a new message overwrites the oldest queued one
+    DROP_NEWEST,    ///< a new message is discarded while the queue is full
+};
+
+/**
+ * @brief Subscriber that deserializes messages into a bounded ring instead of calling a callback.
+ * The application drains the ring in a batch from its own loop, so slow processing doesn't delay
+ * the reception inside uavcanSpinOnce.
+ * @note The ring is not thread-safe, so drain it in the thread that spins the node.
+ */
+template <typename MessageType, uint8_t CAPACITY = 8>
+class DronecanQueuedSubscriber : public DronecanSubscription {
+public:
+    static_assert(CAPACITY > 0, "Queue capacity must be positive");
+
+    DronecanQueuedSubscriber() = default;
+
+    int8_t init(DronecanQueuePolicy policy_=DronecanQueuePolicy::DROP_OLDEST,
+                const DronecanRawFilter& raw_filter_=DronecanRawFilter()) {
+        policy = policy_;
+        raw_filter = raw_filter_;
+        sub_id = DronecanSubscriberTraits<MessageType>::subscribe(transfer_callback);
+        if (sub_id >= 0) {
+            registerInstance(instances, this);
+        }
+        return sub_id;
+    }
+
+    static inline void transfer_callback(CanardRxTransfer* transfer) {
+        auto instance = static_cast<DronecanQueuedSubscriber*>(instances[transfer->sub_id]);
+        if (instance == nullptr || !instance->raw_filter.match(transfer)) {
+            return;
+        }
+        instance->push(transfer);
+    }
+
+    /**
+     * @brief Pass up to max_number of the queued messages to the callback, oldest first
+     * @return the number of processed messages
+     */
+    uint8_t drain(DronecanDelegate<void(const MessageType&)> callback, uint8_t max_number=CAPACITY) {
+        uint8_t counter = 0;
+        while (size != 0 && counter < max_number) {
+            callback(ring[tail]);
+            tail = next(tail);
+            size--;
+            counter++;
+        }
+        return counter;
+    }
+
+    /**
+     * @return false if the queue is empty
+     */
+    bool pop(MessageType* msg) {
+        if (size == 0) {
+            return false;
+        }
+        *msg = ring[tail];
+        tail = next(tail);
+        size--;
+        return true;
+    }
+
+    uint8_t getSize() const {
+        return size;
+    }
+
+    uint32_t getNumberOfOverwritten() const {
+        return overwritten;
+    }
+
+    uint32_t getNumberOfDropped() const {
+        return dropped;
+    }
+
+    static inline std::array<void*, DRONECAN_MAX_SUBS_NUMBER> instances{};
+    DronecanQueuePolicy policy{DronecanQueuePolicy::DROP_OLDEST};
+    DronecanRawFilter raw_filter;
+
+private:
+    static inline uint8_t next(uint8_t idx) {
+        return (idx + 1 < CAPACITY) ? idx + 1 : 0;
+    }
+
+    void push(CanardRxTransfer* transfer) {
+        bool is_full = (size == CAPACITY);
+        if (is_full && policy == DronecanQueuePolicy::DROP_NEWEST) {
+            dropped++;
+            return;
+        }
+
+        uint8_t head = (uint8_t)((tail + size) % CAPACITY);
+        bool is_ok = DronecanSubscriberTraits<MessageType>::deserialize(transfer, &ring[head]) >= 0;
+
+        if (is_full) {
+            // The oldest message has been overwritten even if the new one is broken
+            tail = next(tail);
+            overwritten++;
+            size -= is_ok ? 0 : 1;
+        } else {
+            size += is_ok ? 1 : 0;
+        }
+    }
+
+    MessageType ring[CAPACITY]{};
+    uint8_t tail{0};
+    uint8_t size{0};
+    uint32_t overwritten{0};
+    uint32_t dropped{0};
+};
+
+/**
+ * @brief Subscriber that keeps the latest message per key, e.g. the newest NodeStatus of each node
+ * or the newest EscStatus of each ESC. By default the key is the source node id, a key function can
+ * select a field of the message instead, e.g. esc_index.
+ * The table is updated from the RX path. Each entry is protected by a seqlock, so any thread can read
+ * it without locks while the RX path is never blocked.
+ */
+template <typename MessageType, uint8_t CAPACITY = 8>
+class DronecanLatestValueSubscriber : public DronecanSubscription {
+public:
+    using KeyFunction = uint8_t (*)(const MessageType&);
+
+    DronecanLatestValueSubscriber() = default;
+
+    /**
+     * @param[in] key_function_ extracts the key from the message, nullptr means the source node id
+     */
+    int8_t init(KeyFunction key_function_=nullptr,
+                const DronecanRawFilter& raw_filter_=DronecanRawFilter()) {
+        key_function = key_function_;
+        raw_filter = raw_filter_;
+        sub_id = DronecanSubscriberTraits<MessageType>::subscribe(transfer_callback);
+        if (sub_id >= 0) {
+            registerInstance(instances, this);
+        }
+        return sub_id;
+    }
+
+    static inline void transfer_callback(CanardRxTransfer* transfer) {
+        auto instance = static_cast<DronecanLatestValueSubscriber*>(instances[transfer->sub_id]);
+        if (instance == nullptr || !instance->raw_filter.match(transfer)) {
+            return;
+        }
+
+        MessageType msg{};
+        if (DronecanSubscriberTraits<MessageType>::deserialize(transfer, &msg) < 0) {
+            return;
+        }
+
+        uint8_t key = instance->key_function ? instance->key_function(msg) : transfer->source_node_id;
+        instance->update(key, msg, (uint32_t)(transfer->timestamp_usec / 1000));
+    }
+
+    /**
+     * @brief Copy the latest message with the given key. Can be called from any thread.
+     * @param[out] timestamp_ms is the receive time of the message, optional
+     * @return false if there is no message with such a key or a consistent copy can't be taken
+     */
+    bool read(uint8_t key, MessageType* msg, uint32_t* timestamp_ms=nullptr) const {
+        int16_t idx = find(key);
+        if (idx < 0) {
+            return false;
+        }
+
+        const Entry& entry = entries[idx];
+        for (uint8_t attempt = 0; attempt < MAX_READ_ATTEMPTS; attempt++) {
+            uint32_t seq = entry.seq.load(std::memory_order_acquire);
+            if (seq & 1U) {
+                continue;
+            }
+            MessageType copy = entry.msg;
+            uint32_t timestamp = entry.timestamp_ms;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (entry.seq.load(std::memory_order_relaxed) == seq) {
+                *msg = copy;
+                if (timestamp_ms != nullptr) {
+                    *timestamp_ms = timestamp;
+                }
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @return the age of the latest message with the given key or UINT32_MAX if there is no such message
+     */
+    uint32_t getAgeMs(uint8_t key) const {
+        MessageType msg;
+        uint32_t timestamp_ms;
+        if (!read(key, &msg, &timestamp_ms)) {
+            return UINT32_MAX;
+        }
+        return uavcanPlatformGetTimeMs() - timestamp_ms;
+    }
+
+    /**
+     * @return the number of known keys
+     */
+    uint8_t getSize() const {
+        return size.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @return the key of the entry with the given index, entries are never removed
+     */
+    uint8_t getKey(uint8_t idx) const {
+        return entries[idx].key;
+    }
+
+    /**
+     * @return the number of messages dropped because the table is full
+     */
+    uint32_t getNumberOfDropped() const {
+        return dropped;
+    }
+
+    static inline std::array<void*, DRONECAN_MAX_SUBS_NUMBER> instances{};
+    KeyFunction key_function{nullptr};
+    DronecanRawFilter raw_filter;
+
+private:
+    static constexpr uint8_t MAX_READ_ATTEMPTS = 4;
+
+    struct Entry {
+        std::atomic<uint32_t> seq{0};
+        uint8_t key{0};
+        uint32_t timestamp_ms{0};
+        MessageType msg{};
+    };
+
+    int16_t find(uint8_t key) const {
+        uint8_t number_of_entries = size.load(std::memory_order_acquire);
+        for (uint8_t idx = 0; idx < number_of_entries; idx++) {
+            if (entries[idx].key == key) {
+                return idx;
+            }
+        }
+        return -1;
+    }
+
+    void update(uint8_t key, const MessageType& msg, uint32_t timestamp_ms) {
+        int16_t idx = find(key);
+        if (idx < 0) {
+            uint8_t number_of_entries = size.load(std::memory_order_relaxed);
+            if (number_of_entries >= CAPACITY) {
+                dropped++;
+                return;
+            }
+            idx = number_of_entries;
+            entries[idx].key = key;
+        }
+
+        Entry& entry = entries[idx];
+        uint32_t seq = entry.seq.load(std::memory_order_relaxed);
+        entry.seq.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        entry.msg = msg;
+        entry.timestamp_ms = timestamp_ms;
+        entry.seq.store(seq + 2, std::memory_order_release);
+
+        if (idx == size.load(std::memory_order_relaxed)) {
+            size.store(idx + 1, std::memory_order_release);
+        }
+    }
+
+    Entry entries[CAPACITY];
+    std::atomic<uint8_t> size{0};
+    uint32_t dropped{0};
+};
+
+/**
+ * @brief Lazy view of a received transfer. Fields are decoded on access, so a callback pays only
+ * for the fields it reads. A view is valid only inside the callback.
+ * The generic view provides the transfer metadata and a full deserialization.
+ */
+template <typename MessageType>
+class DronecanViewBase {
+public:
+    explicit DronecanViewBase(const CanardRxTransfer* transfer_) : transfer(transfer_) {}
+
+    inline uint8_t getSourceNodeId() const {
+        return transfer->source_node_id;
+    }
+
+    inline uint64_t getTimestampUs() const {
+        return transfer->timestamp_usec;
+    }
+
+    inline const CanardRxTransfer* getTransfer() const {
+        return transfer;
+    }
+
+    inline int8_t deserialize(MessageType* msg) const {
+        return DronecanSubscriberTraits<MessageType>::deserialize(const_cast<CanardRxTransfer*>(transfer), msg);
+    }
+
+protected:
+    const CanardRxTransfer* transfer;
+};
+
+template <typename MessageType>
+class DronecanView : public DronecanViewBase<MessageType> {
+public:
+    using DronecanViewBase<MessageType>::DronecanViewBase;
+};
+
+template <>
+class DronecanView<RawCommand_t> : public DronecanViewBase<RawCommand_t> {
+public:
+    using DronecanViewBase<RawCommand_t>::DronecanViewBase;
+
+    inline uint8_t size() const {
+        uint32_t number_of_channels = transfer->payload_len * 8U / RAWCOMMAND_BIT_LEN;
+        return std::min(number_of_channels, (uint32_t)NUMBER_OF_RAW_CMD_CHANNELS);
+    }
+
+    /**
+     * @return the channel setpoint or 0 if the message doesn't have this channel
+     */
+    inline int16_t raw_cmd(uint8_t channel) const {
+        int16_t value = 0;
+        if (channel >= size() ||
+                !dronecan_equipment_esc_raw_command_channel_deserialize(transfer, channel, &value)) {
+            return 0;
+        }
+        return value;
+    }
+};
+
+template <>
+class DronecanView<ArrayCommand_t> : public DronecanViewBase<ArrayCommand_t> {
+public:
+    using DronecanViewBase<ArrayCommand_t>::DronecanViewBase;
+
+    inline uint8_t size() const {
+        uint32_t number_of_commands = transfer->payload_len / UAVCAN_EQUIPMENT_ACTUATOR_COMMAND_MESSAGE_SIZE;
+        return std::min(number_of_commands, (uint32_t)NUMBER_OF_ACTUATOR_ARRAY_COMMANDS);
+    }
+
+    inline uint8_t actuator_id(uint8_t idx) const {
+        uint8_t value = 0;
+        canardDecodeScalar(transfer, idx * 32U, 8, false, &value);
+        return value;
+    }
+
+    inline Command_t command(uint8_t idx) const {
+        Command_t cmd{};
+        uint16_t f16_dummy = 0;
+        canardDecodeScalar(transfer, idx * 32U, 8, false, &cmd.actuator_id);
+        canardDecodeScalar(transfer, idx * 32U + 8, 8, false, &cmd.command_type);
+        canardDecodeScalar(transfer, idx * 32U + 16, 16, false, &f16_dummy);
+        cmd.command_value = canardConvertFloat16ToNativeFloat(f16_dummy);
+        return cmd;
+    }
+
+    /**
+     * @return the index of the first command with the given actuator ID or -1 if there is no such command
+     */
+    inline int8_t find(uint8_t id) const {
+        for (uint8_t idx = 0; idx < size(); idx++) {
+            if (actuator_id(idx) == id) {
+                return idx;
+            }
+        }
+        return -1;
+    }
+};
+
+
+/**
+ * @brief RawCommand subscriber that decodes only the channels selected by a bitmask.
+ * Channels outside of the mask keep their previous values, msg.size is the number of received channels.
+ */
+class DronecanMaskedRawCommandSubscriber : public DronecanSubscription {
+public:
+    DronecanMaskedRawCommandSubscriber() = default;
+
+    /**
+     * @param[in] channel_mask_ bit N selects channel N
+     */
+    int8_t init(DronecanDelegate<void(const RawCommand_t&)> callback,
+                uint32_t channel_mask_,
+                const DronecanRawFilter& raw_filter_=DronecanRawFilter()) {
+        user_callback = callback;
+        channel_mask = channel_mask_;
+        raw_filter = raw_filter_;
+        sub_id = DronecanSubscriberTraits<RawCommand_t>::subscribe(transfer_callback);
+        if (sub_id >= 0) {
+            registerInstance(instances, this);
+        }
+        return sub_id;
+    }
+
+    static inline void transfer_callback(CanardRxTransfer* transfer) {
+        auto instance = static_cast<DronecanMaskedRawCommandSubscriber*>(instances[transfer->sub_id]);
+        if (instance == nullptr || !instance->raw_filter.match(transfer)) {
+            return;
+        }
+
+        if (dronecan_equipment_esc_raw_command_masked_deserialize(transfer, instance->channel_mask, &instance->msg) < 0) {
+            return;
+        }
+
+        instance->user_callback(instance->msg);
+    }
+
+    static inline std::array<void*, DRONECAN_MAX_SUBS_NUMBER> instances{};
+    RawCommand_t msg = {};
+    DronecanDelegate<void(const RawCommand_t&)> user_callback;
+    uint32_t channel_mask{0};
+    DronecanRawFilter raw_filter;
+};
+
+/**
+ * @brief ArrayCommand subscriber that decodes each transfer once and calls a handler per actuator.
+ * The handler is found through a lookup table indexed by actuator_id, so the cost per command is
+ * constant regardless of the number of handlers. Commands without a handler are not decoded further.
+ */
+template <uint8_t MAX_HANDLERS = 8>
+class DronecanArrayCommandDispatcher : public DronecanSubscription {
+public:
+    using Handler = DronecanDelegate<void(const Command_t&)>;
+
+    DronecanArrayCommandDispatcher() {
+        lookup.fill(NO_HANDLER);
+    }
+
+    int8_t init(const DronecanRawFilter& raw_filter_=DronecanRawFilter()) {
+        raw_filter = raw_filter_;
+        sub_id = DronecanSubscriberTraits<ArrayCommand_t>::subscribe(transfer_callback);
+        if (sub_id >= 0) {
+            registerInstance(instances, this);
+        }
+        return sub_id;
+    }
+
+    /**
+     * @brief Add or replace the handler of the actuator
+     * @param[in] handler is a function, a small lambda or Handler::bind<&Class::method>(object)
+     * @return false if there is no space for a new handler
+     */
+    bool addHandler(uint8_t actuator_id, Handler handler) {
+        if (!handler) {
+            return false;
+        }
+        if (lookup[actuator_id] != NO_HANDLER) {
+            handlers[lookup[actuator_id]].handler = handler;
+            return true;
+        }
+        if (number_of_handlers >= MAX_HANDLERS) {
+            return false;
+        }
+        handlers[number_of_handlers] = {actuator_id, handler};
+        lookup[actuator_id] = number_of_handlers++;
+        return true;
+    }
+
+    void removeHandler(uint8_t actuator_id) {
+        uint8_t idx = lookup[actuator_id];
+        if (idx == NO_HANDLER) {
+            return;
+        }
+        lookup[actuator_id] = NO_HANDLER;
+        number_of_handlers--;
+        if (idx != number_of_handlers) {
+            handlers[idx] = handlers[number_of_handlers];
+            lookup[handlers[idx].actuator_id] = idx;
+        }
+    }
+
+    uint8_t getNumberOfHandlers() const {
+        return number_of_handlers;
+    }
+
+    static inline void transfer_callback(CanardRxTransfer* transfer) {
+        auto instance = static_cast<DronecanArrayCommandDispatcher*>(instances[transfer->sub_id]);
+        if (instance == nullptr || !instance->raw_filter.match(transfer)) {
+            return;
+        }
+
+        DronecanView<ArrayCommand_t> view(transfer);
+        for (uint8_t idx = 0; idx < view.size(); idx++) {
+            uint8_t handler_idx = instance->lookup[view.actuator_id(idx)];
+            if (handler_idx != NO_HANDLER) {
+                instance->handlers[handler_idx].handler(view.command(idx));
+            }
+        }
+    }
+
+    static inline std::array<void*, DRONECAN_MAX_SUBS_NUMBER> instances{};
+    DronecanRawFilter raw_filter;
+
+private:
+    static constexpr uint8_t NO_HANDLER = 0xFF;
+    static_assert(MAX_HANDLERS < NO_HANDLER, "Too many handlers");
+
+    struct Entry {
+        uint8_t actuator_id;
+        Handler handler;
+    };
+
+    std::array<uint8_t, 256> lookup;
+    Entry handlers[MAX_HANDLERS]{};
+    uint8_t number_of_handlers{0};
+};
+
+/**
+ * @brief Subscriber that passes a lazy DronecanView to the callback instead of a deserialized message.
+ */
+template <typename MessageType>
+class DronecanViewSubscriber : public DronecanSubscription {
+public:
+    DronecanViewSubscriber() = default;
+
+    int8_t init(DronecanDelegate<void(const DronecanView<MessageType>&)> callback,
+                const DronecanRawFilter& raw_filter_=DronecanRawFilter()) {
+        user_callback = callback;
+        raw_filter = raw_filter_;
+        sub_id = DronecanSubscriberTraits<MessageType>::subscribe(transfer_callback);
+        if (sub_id >= 0) {
+            registerInstance(instances, this);
+        }
+        return sub_id;
+    }
+
+    static inline void transfer_callback(CanardRxTransfer* transfer) {
+        auto instance = static_cast<DronecanViewSubscriber*>(instances[transfer->sub_id]);
+        if (instance == nullptr || !instance->raw_filter.match(transfer)) {
+            return;
+        }
+
+        instance->user_callback(DronecanView<MessageType>(transfer));
+    }
+
+    static inline std::array<void*, DRONECAN_MAX_SUBS_NUMBER> instances{};
+    DronecanDelegate<void(const DronecanView<MessageType>&)> user_callback;
+    DronecanRawFilter raw_filter;
+};
+
+/**
+ * @brief Server side of a service: the handler receives the raw request and answers with uavcanRespond,
+ * or keeps uavcanDeferResponse(transfer) and answers later with uavcanRespondDeferred.
+ * Broadcasts and responses with the same data type id are ignored.
+ */
+class DronecanServiceHandler : public DronecanSubscription {
+public:
+    using Handler = DronecanDelegate<void(CanardRxTransfer*)>;
+
+    DronecanServiceHandler() = default;
+
+    int8_t init(uint64_t signature, uint16_t id, Handler handler_) {
+        handler = handler_;
+        sub_id = uavcanSubscribe(signature, id, transfer_callback);
+        if (sub_id >= 0) {
+            registerInstance(instances, this);
+        }
+        return sub_id;
+    }
+
+    static inline void transfer_callback(CanardRxTransfer* transfer) {
+        auto instance = static_cast<DronecanServiceHandler*>(instances[transfer->sub_id]);
+        if (instance == nullptr || transfer->transfer_type != CanardTransferTypeRequest) {
+            return;
+        }
+        instance->handler(transfer);
+    }
+
     static inline std::array<void*, DRONECAN_MAX_SUBS_NUMBER> instances{};
-    static inline MessageType msg = {};
-    void (*user_callback)(const MessageType&){nullptr};
-    bool (*filter)(const MessageType&){nullptr};
+    Handler handler;
 };
 
 #endif  // LIBDCNODE_SUBSCRIBER_HPP_
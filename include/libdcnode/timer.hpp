@@ -0,0 +1,50 @@
+/*
+ * Copyright (C) 2025 Dmitry Ponomarev <ponomarevda96@gmail.com>
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef LIBDCNODE_TIMER_HPP_
+#define LIBDCNODE_TIMER_HPP_
+
+#include <stdint.h>
+#include "libdcnode/dronecan.h"
+#include "libdcnode/delegate.hpp"
+
+/**
+ * @brief Periodic callback driven by the application loop, e.g. next to uavcanSpinOnce.
+ * If the loop was late, the callback is called once and the next deadline is moved forward,
+ * so missed periods are not replayed.
+ */
+class DronecanTimer {
+public:
+    using Callback = DronecanDelegate<void()>;
+
+    DronecanTimer() = default;
+
+    void init(uint32_t period_ms_, Callback callback) {
+        period_ms = period_ms_;
+        user_callback = callback;
+        next_time_ms = uavcanPlatformGetTimeMs() + period_ms;
+    }
+
+    void spinOnce() {
+        uint32_t crnt_time_ms = uavcanPlatformGetTimeMs();
+        if (!user_callback || static_cast<int32_t>(crnt_time_ms - next_time_ms) < 0) {
+            return;
+        }
+
+        next_time_ms += period_ms;
+        if (static_cast<int32_t>(crnt_time_ms - next_time_ms) >= 0) {
+            next_time_ms = crnt_time_ms + period_ms;
+        }
+        user_callback();
+    }
+
+    uint32_t period_ms{0};
+    uint32_t next_time_ms{0};
+    Callback user_callback;
+};
+
+#endif  // LIBDCNODE_TIMER_HPP_
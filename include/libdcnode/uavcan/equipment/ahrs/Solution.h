@@ -13,7 +13,7 @@
 
 #define UAVCAN_EQUIPMENT_AHRS_SOLUTION_ID                           1000
 #define UAVCAN_EQUIPMENT_AHRS_SOLUTION_SIGNATURE                    0x72a63a3c6f41fa9b
-#define UAVCAN_EQUIPMENT_AHRS_SOLUTION_MESSAGE_SIZE                 29  // 668 bits
+#define UAVCAN_EQUIPMENT_AHRS_SOLUTION_MESSAGE_SIZE                 29  // 232 bits without covariances
 #define UAVCAN_EQUIPMENT_AHRS_SOLUTION                              UAVCAN_EXPAND(UAVCAN_EQUIPMENT_AHRS_SOLUTION)
 #define UAVCAN_EQUIPMENT_AHRS_SOLUTION UAVCAN_EXPAND(UAVCAN_EQUIPMENT_AHRS_SOLUTION)
 
@@ -86,6 +86,63 @@ static inline int8_t dronecan_equipment_ahrs_solution_deserialize(
 }
 
 
+/**
+ * @brief Fields of uavcan.equipment.ahrs.Solution that can be serialized independently.
+ * Covariances are always empty, so every field occupies a fixed bit range.
+ */
+typedef enum {
+    AHRS_SOLUTION_FIELD_TIMESTAMP = 0,          // uint56, bits [0, 56)
+    AHRS_SOLUTION_FIELD_ORIENTATION,            // float16[4] + void4 + uint4 len, bits [56, 128)
+    AHRS_SOLUTION_FIELD_ANGULAR_VELOCITY,       // float16[3] + void4 + uint4 len, bits [128, 184)
+    AHRS_SOLUTION_FIELD_LINEAR_ACCELERATION,    // float16[3], bits [184, 232)
+    AHRS_SOLUTION_NUMBER_OF_FIELDS,
+} AhrsSolutionField;
+
+static inline int8_t dronecan_equipment_ahrs_solution_serialize_field(
+    const AhrsSolution_t* const obj,
+    uint8_t* const buffer,
+    AhrsSolutionField field)
+{
+    if ((obj == NULL) || (buffer == NULL)) {
+        return -2;
+    }
+
+    const uint8_t void4_and_covariance_len = 0;
+    size_t offset;
+    switch (field) {
+        case AHRS_SOLUTION_FIELD_TIMESTAMP:
+            canardEncodeScalar(buffer, 0,  56,  &obj->timestamp);
+            break;
+        case AHRS_SOLUTION_FIELD_ORIENTATION:
+            offset = 56;
+            for (uint_fast8_t idx = 0; idx < 4; idx++) {
+                canardEncodeFloat16(buffer, offset, obj->orientation_xyzw[idx]);
+                offset += 16;
+            }
+            canardEncodeScalar(buffer, offset, 8, &void4_and_covariance_len);
+            break;
+        case AHRS_SOLUTION_FIELD_ANGULAR_VELOCITY:
+            offset = 128;
+            for (uint_fast8_t idx = 0; idx < 3; idx++) {
+                canardEncodeFloat16(buffer, offset, obj->angular_velocity[idx]);
+                offset += 16;
+            }
+            canardEncodeScalar(buffer, offset, 8, &void4_and_covariance_len);
+            break;
+        case AHRS_SOLUTION_FIELD_LINEAR_ACCELERATION:
+            offset = 184;
+            for (uint_fast8_t idx = 0; idx < 3; idx++) {
+                canardEncodeFloat16(buffer, offset, obj->linear_acceleration[idx]);
+                offset += 16;
+            }
+            break;
+        default:
+            return -2;
+    }
+
+    return 0;
+}
+
 static inline int8_t dronecan_equipment_ahrs_solution_serialize(
     const AhrsSolution_t* const obj,
     uint8_t* const buffer,
@@ -100,31 +157,8 @@ static inline int8_t dronecan_equipment_ahrs_solution_serialize(
         return -3;
     }
 
-    size_t offset = 0;
-    canardEncodeScalar(buffer, 0,  56,  &obj->timestamp);
-    offset += 56;
-
-    for (uint_fast8_t idx = 0; idx < 3; idx++) {
-        canardEncodeFloat16(buffer, offset, obj->orientation_xyzw[idx]);
-        offset += 16;
-    }
-
-    offset += 4;
-    canardEncodeScalar(buffer, offset, 4,  0);
-    offset += 4;  // covariance len
-
-    for (uint_fast8_t idx = 0; idx < 2; idx++) {
-        canardEncodeFloat16(buffer, offset, obj->angular_velocity[idx]);
-        offset += 16;
-    }
-
-    offset += 4;  // void4
-    canardEncodeScalar(buffer, offset, 4,  0);
-    offset += 4;  // covariance len
-
-    for (uint_fast8_t idx = 0; idx < 2; idx++) {
-        canardEncodeFloat16(buffer, offset, obj->linear_acceleration[idx]);
-        offset += 16;
+    for (uint_fast8_t field = 0; field < AHRS_SOLUTION_NUMBER_OF_FIELDS; field++) {
+        dronecan_equipment_ahrs_solution_serialize_field(obj, buffer, (AhrsSolutionField)field);
     }
 
     return 0;
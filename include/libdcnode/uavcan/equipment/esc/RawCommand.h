@@ -20,6 +20,7 @@
 #define RAWCOMMAND_BIT_LEN                                          14
 #define NUMBER_OF_RAW_CMD_CHANNELS                                  20
 #define MIN_RAWCOMMAND_CHANNEL                                      0
+#define RAWCOMMAND_MAX_PAYLOAD_SIZE                                 ((NUMBER_OF_RAW_CMD_CHANNELS * RAWCOMMAND_BIT_LEN + 7) / 8)
 
 #define UAVCAN_EQUIPMENT_ESC_RAWCOMMAND UAVCAN_EXPAND(UAVCAN_EQUIPMENT_ESC_RAWCOMMAND)
 
@@ -80,6 +81,50 @@ static inline bool dronecan_equipment_esc_raw_command_channel_deserialize(
     return true;
 }
 
+/**
+ * @brief Decode only the channels selected by channel_mask (bit N is channel N).
+ * The payload is copied into a contiguous buffer once, then each channel is extracted with a single
+ * 24-bit load and shifts. Channels outside of the mask are not modified.
+ * @return the number of channels in the message, obj->size is set to the same value
+ */
+static inline int8_t dronecan_equipment_esc_raw_command_masked_deserialize(
+    const CanardRxTransfer* transfer,
+    uint32_t channel_mask,
+    RawCommand_t* obj)
+{
+    if ((transfer == NULL) || (obj == NULL)) {
+        return -2;
+    }
+
+    // 2 extra bytes let the 24-bit window of the last channel stay inside the buffer
+    uint8_t payload[RAWCOMMAND_MAX_PAYLOAD_SIZE + 2];
+    uint16_t payload_len = uavcanCopyPayload(transfer, payload, RAWCOMMAND_MAX_PAYLOAD_SIZE);
+    payload[payload_len] = 0;
+    payload[payload_len + 1] = 0;
+
+    uint8_t size = (uint8_t)((payload_len * 8U) / RAWCOMMAND_BIT_LEN);
+    channel_mask &= (1UL << size) - 1U;
+
+    while (channel_mask != 0) {
+        uint8_t ch_num = (uint8_t)__builtin_ctz(channel_mask);
+        channel_mask &= channel_mask - 1U;
+
+        // The bit stream is MSB first, a 14-bit value is stored as a low byte and 6 high bits
+        const uint32_t first_bit = ch_num * RAWCOMMAND_BIT_LEN;
+        const uint8_t* ptr = &payload[first_bit >> 3];
+        const uint32_t window = ((uint32_t)ptr[0] << 16) | ((uint32_t)ptr[1] << 8) | ptr[2];
+        const uint32_t bits = (window >> (24U - RAWCOMMAND_BIT_LEN - (first_bit & 7U))) & 0x3FFFU;
+        uint16_t value = (uint16_t)((bits >> 6) | ((bits & 0x3FU) << 8));
+        if (value & 0x2000U) {
+            value |= 0xC000U;
+        }
+        obj->raw_cmd[ch_num] = (int16_t)value;
+    }
+
+    obj->size = size;
+    return size;
+}
+
 static inline int8_t dronecan_equipment_esc_raw_command_serialize(
     const RawCommand_t* const obj, uint8_t* const buffer, size_t* const inout_buffer_size_bytes,  uint8_t num_cmds) {
     if ((obj == NULL) || (buffer == NULL) || (inout_buffer_size_bytes == NULL)) {
@@ -9,11 +9,13 @@
 #define UAVCAN_EQUIPMENT_ESC_STATUS_H_
 
 #include <stdbool.h>
+#include "libdcnode/dronecan.h"
 #include "libdcnode/serialization_internal.h"
 
 #define UAVCAN_EQUIPMENT_ESC_STATUS_ID                              1034
 #define UAVCAN_EQUIPMENT_ESC_STATUS_SIGNATURE                       0xa9af28aea2fbb254
 #define UAVCAN_EQUIPMENT_ESC_STATUS_MESSAGE_SIZE                    14  // 110 / 8
+#define UAVCAN_EQUIPMENT_ESC_STATUS UAVCAN_EXPAND(UAVCAN_EQUIPMENT_ESC_STATUS)
 
 #define ESC_STATUS_MAX_IDX 31
 typedef struct {
@@ -76,6 +78,36 @@ static inline int8_t dronecan_equipment_esc_status_publish(
     return 0;
 }
 
+static inline int8_t dronecan_equipment_esc_status_deserialize(
+    const CanardRxTransfer* transfer, EscStatus_t* obj)
+{
+    if ((transfer == NULL) || (obj == NULL)) {
+        return -2;
+    }
+
+    uint16_t voltage;
+    uint16_t current;
+    uint16_t temperature;
+
+    canardDecodeScalar(transfer, 0,   32, false, &obj->error_count);
+    canardDecodeScalar(transfer, 32,  16, false, &voltage);
+    canardDecodeScalar(transfer, 48,  16, false, &current);
+    canardDecodeScalar(transfer, 64,  16, false, &temperature);
+    canardDecodeScalar(transfer, 80,  18, true,  &obj->rpm);
+    canardDecodeScalar(transfer, 98,  7,  false, &obj->power_rating_pct);
+    canardDecodeScalar(transfer, 105, 5,  false, &obj->esc_index);
+
+    obj->voltage = canardConvertFloat16ToNativeFloat(voltage);
+    obj->current = canardConvertFloat16ToNativeFloat(current);
+    obj->temperature = canardConvertFloat16ToNativeFloat(temperature);
+
+    return 0;
+}
+
+static inline int8_t uavcanSubscribeEscStatus(void (*transfer_callback)(CanardRxTransfer*)) {
+    return uavcanSubscribe(UAVCAN_EQUIPMENT_ESC_STATUS, transfer_callback);
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -52,6 +52,120 @@ typedef struct {
 extern "C" {
 #endif
 
+/**
+ * @brief Fields of uavcan.equipment.gnss.Fix2 that can be serialized independently.
+ * Every field occupies a fixed bit range, so a cached serialized image can be updated partially.
+ */
+typedef enum {
+    GNSS_FIX2_FIELD_TIMESTAMP = 0,          // uint56, bits [0, 56)
+    GNSS_FIX2_FIELD_GNSS_TIMESTAMP,         // uint56, bits [56, 112)
+    GNSS_FIX2_FIELD_GNSS_TIME_STANDARD,     // uint3 + void13, bits [112, 128)
+    GNSS_FIX2_FIELD_NUM_LEAP_SECONDS,       // uint8, bits [128, 136)
+    GNSS_FIX2_FIELD_LONGITUDE,              // int37, bits [136, 173)
+    GNSS_FIX2_FIELD_LATITUDE,               // int37, bits [173, 210)
+    GNSS_FIX2_FIELD_HEIGHT_ELLIPSOID,       // int27, bits [210, 237)
+    GNSS_FIX2_FIELD_HEIGHT_MSL,             // int27, bits [237, 264)
+    GNSS_FIX2_FIELD_NED_VELOCITY,           // float32[3], bits [264, 360)
+    GNSS_FIX2_FIELD_SATS_USED,              // uint6, bits [360, 366)
+    GNSS_FIX2_FIELD_STATUS,                 // uint2, bits [366, 368)
+    GNSS_FIX2_FIELD_MODE,                   // uint4, bits [368, 372)
+    GNSS_FIX2_FIELD_SUB_MODE,               // uint6, bits [372, 378)
+    GNSS_FIX2_FIELD_COVARIANCE,             // uint6 len + float16[6], bits [378, 480)
+    GNSS_FIX2_FIELD_PDOP,                   // float16, bits [480, 496)
+    GNSS_FIX2_FIELD_ECEF,                   // ECEFPositionVelocity[<=1], bits [496, 712)
+    GNSS_FIX2_NUMBER_OF_FIELDS,
+} GnssFix2Field;
+
+static inline int8_t dronecan_equipment_gnss_fix2_serialize_field(
+    const GnssFix2* const obj,
+    uint8_t* const buffer,
+    GnssFix2Field field)
+{
+    if ((obj == NULL) || (buffer == NULL)) {
+        return -2;
+    }
+
+    uint32_t offset;
+    switch (field) {
+        case GNSS_FIX2_FIELD_TIMESTAMP:
+            canardEncodeScalar(buffer, 0, 56, &obj->timestamp);
+            break;
+        case GNSS_FIX2_FIELD_GNSS_TIMESTAMP:
+            canardEncodeScalar(buffer, 56, 56, &obj->gnss_timestamp);
+            break;
+        case GNSS_FIX2_FIELD_GNSS_TIME_STANDARD: {
+            const uint16_t void13 = 0;
+            canardEncodeScalar(buffer, 112, 3, &obj->gnss_time_standard);
+            canardEncodeScalar(buffer, 115, 13, &void13);
+            break;
+        }
+        case GNSS_FIX2_FIELD_NUM_LEAP_SECONDS:
+            canardEncodeScalar(buffer, 128, 8, &obj->num_leap_seconds);
+            break;
+        case GNSS_FIX2_FIELD_LONGITUDE:
+            canardEncodeScalar(buffer, 136, 37, &obj->longitude_deg_1e8);
+            break;
+        case GNSS_FIX2_FIELD_LATITUDE:
+            canardEncodeScalar(buffer, 173, 37, &obj->latitude_deg_1e8);
+            break;
+        case GNSS_FIX2_FIELD_HEIGHT_ELLIPSOID:
+            canardEncodeScalar(buffer, 210, 27, &obj->height_ellipsoid_mm);
+            break;
+        case GNSS_FIX2_FIELD_HEIGHT_MSL:
+            canardEncodeScalar(buffer, 237, 27, &obj->height_msl_mm);
+            break;
+        case GNSS_FIX2_FIELD_NED_VELOCITY:
+            offset = 264;
+            for (uint_fast8_t idx = 0; idx < 3; idx++) {
+                canardEncodeFloat32(buffer, offset, obj->ned_velocity[idx]);
+                offset += 32;
+            }
+            break;
+        case GNSS_FIX2_FIELD_SATS_USED:
+            canardEncodeScalar(buffer, 360, 6, &obj->sats_used);
+            break;
+        case GNSS_FIX2_FIELD_STATUS:
+            canardEncodeScalar(buffer, 366, 2, &obj->status);
+            break;
+        case GNSS_FIX2_FIELD_MODE:
+            canardEncodeScalar(buffer, 368, 4, &obj->mode);
+            break;
+        case GNSS_FIX2_FIELD_SUB_MODE:
+            canardEncodeScalar(buffer, 372, 6, &obj->sub_mode);
+            break;
+        case GNSS_FIX2_FIELD_COVARIANCE: {
+            const uint8_t covariance_len = 6;
+            canardEncodeScalar(buffer, 378, 6, &covariance_len);
+            offset = 384;
+            for (uint_fast8_t idx = 0; idx < covariance_len; idx++) {
+                canardEncodeFloat16(buffer, offset, obj->covariance[idx]);
+                offset += 16;
+            }
+            break;
+        }
+        case GNSS_FIX2_FIELD_PDOP:
+            canardEncodeFloat16(buffer, 480, obj->pdop);
+            break;
+        case GNSS_FIX2_FIELD_ECEF:
+            if (obj->ecef_size == 1) {
+                dronecan_equipment_gnss_ecef_serialize(buffer + 496 / 8, &obj->ecef);
+            }
+            break;
+        default:
+            return -2;
+    }
+
+    return 0;
+}
+
+/**
+ * @return the payload length in bits: either 496 bits (62 bytes) or 496+216 bits (89 bytes)
+ */
+static inline int32_t dronecan_equipment_gnss_fix2_get_bit_length(const GnssFix2* const obj)
+{
+    return (obj->ecef_size == 1) ? 496 + 216 : 496;
+}
+
 static inline int32_t dronecan_equipment_gnss_fix2_serialize(
     const GnssFix2* const obj,
     uint8_t* const buffer,
@@ -66,62 +180,11 @@ static inline int32_t dronecan_equipment_gnss_fix2_serialize(
         return -3;
     }
 
-    uint32_t offset = 0;
-
-    canardEncodeScalar(buffer, offset,  56, &obj->timestamp);
-    offset += 56;
-    canardEncodeScalar(buffer, offset,  56, &obj->gnss_timestamp);
-    offset += 56;
-    canardEncodeScalar(buffer, offset,  3,  &obj->gnss_time_standard);
-    offset += 3;
-
-    // void13   # Reserved space
-    offset += 13;
-
-    canardEncodeScalar(buffer, offset, 8,  &obj->num_leap_seconds);
-    offset += 8;
-
-    canardEncodeScalar(buffer, offset, 37, &obj->longitude_deg_1e8);
-    offset += 37;
-    canardEncodeScalar(buffer, offset, 37, &obj->latitude_deg_1e8);
-    offset += 37;
-    canardEncodeScalar(buffer, offset, 27, &obj->height_ellipsoid_mm);
-    offset += 27;
-    canardEncodeScalar(buffer, offset, 27, &obj->height_msl_mm);
-    offset += 27;
-
-    canardEncodeFloat32(buffer, offset, obj->ned_velocity[0]);
-    offset += 32;
-    canardEncodeFloat32(buffer, offset, obj->ned_velocity[1]);
-    offset += 32;
-    canardEncodeFloat32(buffer, offset, obj->ned_velocity[2]);
-    offset += 32;
-
-    canardEncodeScalar(buffer, offset, 6,  &obj->sats_used);
-    offset += 6;
-    canardEncodeScalar(buffer, offset, 2,  &obj->status);
-    offset += 2;
-    canardEncodeScalar(buffer, offset, 4,  &obj->mode);
-    offset += 4;
-    canardEncodeScalar(buffer, offset, 6,  &obj->sub_mode);
-    offset += 6;
-
-    uint8_t covariance_len = 6;
-    canardEncodeScalar(buffer, offset, 6,  &covariance_len);
-    offset += 6;
-    for (uint_fast8_t idx = 0; idx < 6; idx++) {
-        canardEncodeFloat16(buffer, offset, obj->covariance[idx]);
-        offset += 16;
-    }
-
-    canardEncodeFloat16(buffer, offset, obj->pdop);
-    offset += 16;
-
-    if (obj->ecef_size == 1) {
-        offset += dronecan_equipment_gnss_ecef_serialize(buffer+offset/8, &obj->ecef);
+    for (uint_fast8_t field = 0; field < GNSS_FIX2_NUMBER_OF_FIELDS; field++) {
+        dronecan_equipment_gnss_fix2_serialize_field(obj, buffer, (GnssFix2Field)field);
     }
 
-    return offset;  // either 496 bits (62 bytes) or 496+216 bits (89 bytes)
+    return dronecan_equipment_gnss_fix2_get_bit_length(obj);
 }
 
 static inline int8_t dronecan_equipment_gnss_fix2_publish(
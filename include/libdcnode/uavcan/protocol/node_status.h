@@ -66,6 +66,27 @@ static inline void uavcanEncodeNodeStatus(
     canardEncodeScalar(buffer,  40, 16, &node_status->vendor_specific_status_code);
 }
 
+static inline int8_t uavcanDecodeNodeStatus(
+    const CanardRxTransfer* transfer,
+    NodeStatus_t* node_status)
+{
+    if ((transfer == NULL) || (node_status == NULL)) {
+        return -2;
+    }
+
+    uint8_t health_u8;
+    uint8_t mode_u8;
+    canardDecodeScalar(transfer, 0,  32, false, &node_status->uptime_sec);
+    canardDecodeScalar(transfer, 32, 2,  false, &health_u8);
+    canardDecodeScalar(transfer, 34, 3,  false, &mode_u8);
+    canardDecodeScalar(transfer, 37, 3,  false, &node_status->sub_mode);
+    canardDecodeScalar(transfer, 40, 16, false, &node_status->vendor_specific_status_code);
+    node_status->health = (NodeStatusHealth_t)health_u8;
+    node_status->mode = (NodeStatusMode_t)mode_u8;
+
+    return 0;
+}
+
 #ifdef __cplusplus
 }
 #endif
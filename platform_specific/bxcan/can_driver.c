@@ -9,6 +9,17 @@
 #include "canard_stm32.h"
 #include "main.h"
 
+#ifndef CAN_DRIVER_RX_INTERRUPT
+    #define CAN_DRIVER_RX_INTERRUPT 0
+#endif
+
+#if CAN_DRIVER_RX_INTERRUPT
+#include "libdcnode/dronecan.h"
+#include "libdcnode/can_rx_fifo.h"
+
+static CanRxFifo rx_fifo;
+#endif
+
 int16_t canDriverInit(uint32_t can_speed, uint8_t can_driver_idx) {
     (void)can_driver_idx;
     CanardSTM32CANTimings timings;
@@ -24,13 +35,40 @@ int16_t canDriverInit(uint32_t can_speed, uint8_t can_driver_idx) {
         return res;
     }
 
+#if CAN_DRIVER_RX_INTERRUPT
+    canardSTM32EnableRxInterrupts();
+#endif
+
     return 0;
 }
 
 int16_t canDriverReceive(CanardCANFrame* const rx_frame, uint8_t can_driver_idx) {
     (void)can_driver_idx;
+#if CAN_DRIVER_RX_INTERRUPT
+    return canRxFifoPop(&rx_fifo, rx_frame) ? 1 : 0;
+#else
     return canardSTM32Receive(rx_frame);
+#endif
+}
+
+int16_t canDriverReceiveTimestamped(CanardCANFrame* const rx_frame,
+                                    uint64_t* inout_timestamp_usec,
+                                    uint8_t can_driver_idx) {
+    (void)inout_timestamp_usec;     // the frames are not timestamped, the time of the spin is used
+    return canDriverReceive(rx_frame, can_driver_idx);
+}
+
+#if CAN_DRIVER_RX_INTERRUPT
+void canDriverRxIrqHandler(uint8_t can_driver_idx) {
+    (void)can_driver_idx;
+    CanardCANFrame frame;
+    while (canardSTM32Receive(&frame) > 0) {
+        if (!uavcanHandleFrameFromIsr(&frame, HAL_GetTick() * 1000ULL)) {
+            canRxFifoPush(&rx_fifo, &frame);
+        }
+    }
 }
+#endif
 
 int16_t canDriverTransmit(const CanardCANFrame* const tx_frame, uint8_t can_driver_idx) {
     (void)can_driver_idx;
@@ -42,5 +80,9 @@ uint64_t canDriverGetErrorCount() {
 }
 
 uint64_t canDriverGetRxOverflowCount() {
+#if CAN_DRIVER_RX_INTERRUPT
+    return canardSTM32GetStats().rx_overflow_count + rx_fifo.overflow_count;
+#else
     return canardSTM32GetStats().rx_overflow_count;
+#endif
 }
@@ -448,6 +448,12 @@ int16_t canardSTM32Receive(CanardCANFrame* const out_frame)
 }
 
 
+void canardSTM32EnableRxInterrupts(void)
+{
+    BXCAN->IER |= CANARD_STM32_CAN_IER_FMPIE0 | CANARD_STM32_CAN_IER_FMPIE1;
+}
+
+
 int16_t canardSTM32ConfigureAcceptanceFilters(const CanardSTM32AcceptanceFilterConfiguration* const filter_configs,
                                               const uint8_t num_filter_configs)
 {
@@ -153,6 +153,12 @@ int16_t canardSTM32Transmit(const CanardCANFrame* const frame);
  */
 int16_t canardSTM32Receive(CanardCANFrame* const out_frame);
 
+/**
+ * Enables the FIFO message pending interrupts of both RX FIFO.
+ * The corresponding NVIC interrupts must be enabled by the application.
+ */
+void canardSTM32EnableRxInterrupts(void);
+
 /**
  * Sets up acceptance filters according to the provided list of ID and masks.
  * Note that when the interface is reinitialized, hardware acceptance filters are reset.
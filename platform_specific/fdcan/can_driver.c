@@ -14,6 +14,15 @@
     #define NUM_OF_CAN_BUSES 1
 #endif
 
+#ifndef CAN_DRIVER_RX_INTERRUPT
+    #define CAN_DRIVER_RX_INTERRUPT 0
+#endif
+
+#if CAN_DRIVER_RX_INTERRUPT
+#include "libdcnode/dronecan.h"
+#include "libdcnode/can_rx_fifo.h"
+#endif
+
 extern FDCAN_HandleTypeDef hfdcan1;
 extern FDCAN_HandleTypeDef hfdcan2;
 
@@ -24,6 +33,9 @@ typedef struct{
     size_t err_counter;
     size_t tx_counter;
     size_t rx_counter;
+#if CAN_DRIVER_RX_INTERRUPT
+    CanRxFifo rx_fifo;
+#endif
 } CanDriver;
 
 static CanDriver driver[NUM_OF_CAN_BUSES] = {
@@ -56,14 +68,18 @@ int16_t canDriverInit(uint32_t can_speed, uint8_t can_driver_idx) {
         return -1;
     }
 
+#if CAN_DRIVER_RX_INTERRUPT
+    // The FDCAN interrupt line must be enabled in NVIC, HAL_FDCAN_IRQHandler calls the callback below
+    if (HAL_FDCAN_ActivateNotification(driver[can_driver_idx].handler,
+                                       FDCAN_IT_RX_FIFO0_NEW_MESSAGE, 0) != HAL_OK) {
+        return -1;
+    }
+#endif
+
     return 0;
 }
 
-int16_t canDriverReceive(CanardCANFrame* const rx_frame, uint8_t can_driver_idx) {
-    if (rx_frame == NULL) {
-        return 0;
-    }
-
+static int16_t receiveFromHardware(CanardCANFrame* const rx_frame, uint8_t can_driver_idx) {
     FDCAN_RxHeaderTypeDef rx_header;
 
     HAL_StatusTypeDef res = HAL_FDCAN_GetRxMessage(driver[can_driver_idx].handler,
@@ -82,6 +98,48 @@ int16_t canDriverReceive(CanardCANFrame* const rx_frame, uint8_t can_driver_idx)
     return 1;
 }
 
+int16_t canDriverReceive(CanardCANFrame* const rx_frame, uint8_t can_driver_idx) {
+    if (rx_frame == NULL) {
+        return 0;
+    }
+
+#if CAN_DRIVER_RX_INTERRUPT
+    return canRxFifoPop(&driver[can_driver_idx].rx_fifo, rx_frame) ? 1 : 0;
+#else
+    return receiveFromHardware(rx_frame, can_driver_idx);
+#endif
+}
+
+int16_t canDriverReceiveTimestamped(CanardCANFrame* const rx_frame,
+                                    uint64_t* inout_timestamp_usec,
+                                    uint8_t can_driver_idx) {
+    (void)inout_timestamp_usec;     // the frames are not timestamped, the time of the spin is used
+    return canDriverReceive(rx_frame, can_driver_idx);
+}
+
+#if CAN_DRIVER_RX_INTERRUPT
+void canDriverRxIrqHandler(uint8_t can_driver_idx) {
+    CanardCANFrame frame;
+    while (receiveFromHardware(&frame, can_driver_idx) > 0) {
+        if (!uavcanHandleFrameFromIsr(&frame, HAL_GetTick() * 1000ULL)) {
+            canRxFifoPush(&driver[can_driver_idx].rx_fifo, &frame);
+        }
+    }
+}
+
+void HAL_FDCAN_RxFifo0Callback(FDCAN_HandleTypeDef* hfdcan, uint32_t RxFifo0ITs) {
+    if ((RxFifo0ITs & FDCAN_IT_RX_FIFO0_NEW_MESSAGE) == 0) {
+        return;
+    }
+
+    for (uint8_t idx = 0; idx < NUM_OF_CAN_BUSES; idx++) {
+        if (driver[idx].handler == hfdcan) {
+            canDriverRxIrqHandler(idx);
+        }
+    }
+}
+#endif
+
 int16_t canDriverTransmit(const CanardCANFrame* const tx_frame, uint8_t can_driver_idx) {
     driver[can_driver_idx].tx_header.Identifier = tx_frame->id;
     driver[can_driver_idx].tx_header.DataLength = tx_frame->data_len << 4*4;
@@ -102,5 +160,13 @@ uint64_t canDriverGetErrorCount() {
 }
 
 uint64_t canDriverGetRxOverflowCount() {
+#if CAN_DRIVER_RX_INTERRUPT
+    uint64_t overflow_count = 0;
+    for (uint8_t idx = 0; idx < NUM_OF_CAN_BUSES; idx++) {
+        overflow_count += driver[idx].rx_fifo.overflow_count;
+    }
+    return overflow_count;
+#else
     return 0;
+#endif
 }
@@ -12,13 +12,23 @@
     #define SOCKETCAN_INTERFACE_NAME "slcan0"
 #endif
 
+#ifndef SOCKETCAN_RX_THREAD
+    #define SOCKETCAN_RX_THREAD 0
+#endif
+
 SocketCANInstance socket_can_instance;
 const char* can_iface_name = SOCKETCAN_INTERFACE_NAME;
 
 int16_t canDriverInit(uint32_t can_speed, uint8_t can_driver_idx) {
     (void)can_speed;
     (void)can_driver_idx;
-    return socketcanInit(&socket_can_instance, can_iface_name);;
+    int16_t res = socketcanInit(&socket_can_instance, can_iface_name);
+#if SOCKETCAN_RX_THREAD
+    if (res >= 0) {
+        res = socketcanStartRxThread(&socket_can_instance);
+    }
+#endif
+    return res;
 }
 
 int16_t canDriverReceive(CanardCANFrame* const rx_frame, uint8_t can_driver_idx) {
@@ -27,6 +37,21 @@ int16_t canDriverReceive(CanardCANFrame* const rx_frame, uint8_t can_driver_idx)
     return socketcanReceive(&socket_can_instance, rx_frame, 0);
 }
 
+int16_t canDriverReceiveTimestamped(CanardCANFrame* const rx_frame,
+                                    uint64_t* inout_timestamp_usec,
+                                    uint8_t can_driver_idx) {
+    (void)can_driver_idx;
+    rx_frame->iface_id = 0;
+    uint64_t arrival_usec = 0;
+    int16_t res = socketcanReceiveTimestamped(&socket_can_instance, rx_frame, &arrival_usec, 0);
+    if (res > 0) {
+        // The socketcan clock differs from the clock of the node, so only the waiting time is taken from it
+        uint64_t age_usec = socketcanGetMonotonicUsec() - arrival_usec;
+        *inout_timestamp_usec = (*inout_timestamp_usec > age_usec) ? *inout_timestamp_usec - age_usec : 0;
+    }
+    return res;
+}
+
 int16_t canDriverTransmit(const CanardCANFrame* const tx_frame, uint8_t can_driver_idx) {
     (void)can_driver_idx;
     return socketcanTransmit(&socket_can_instance, tx_frame, 0);
@@ -37,5 +62,6 @@ uint64_t canDriverGetErrorCount() {
 }
 
 uint64_t canDriverGetRxOverflowCount() {
-    return 0;
+    SocketCANRxStats stats = socketcanGetRxStats();
+    return stats.ring_overflow_count + stats.kernel_drop_count;
 }
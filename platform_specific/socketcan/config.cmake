@@ -2,3 +2,14 @@ set(DRONECAN_PLATFORM_SOURCES
     ${CMAKE_CURRENT_LIST_DIR}/can_driver.c
     ${CMAKE_CURRENT_LIST_DIR}/socketcan.c
 )
+
+# Drain the CAN socket in a dedicated thread, see socketcanStartRxThread.
+# The target that compiles the platform sources adds the definitions and the libraries below.
+set(DRONECAN_PLATFORM_DEFINITIONS)
+set(DRONECAN_PLATFORM_LIBRARIES)
+option(SOCKETCAN_RX_THREAD "Receive CAN frames in a dedicated thread" OFF)
+if(SOCKETCAN_RX_THREAD)
+    find_package(Threads REQUIRED)
+    list(APPEND DRONECAN_PLATFORM_DEFINITIONS SOCKETCAN_RX_THREAD=1)
+    list(APPEND DRONECAN_PLATFORM_LIBRARIES Threads::Threads)
+endif()
@@ -19,6 +19,38 @@
 #include <linux/can.h>
 #include <errno.h>
 #include <stdlib.h>
+#include <time.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+#if (SOCKETCAN_RX_RING_SIZE & (SOCKETCAN_RX_RING_SIZE - 1)) != 0
+# error "SOCKETCAN_RX_RING_SIZE must be a power of two"
+#endif
+
+typedef struct
+{
+    CanardCANFrame frame;
+    uint64_t timestamp_usec;
+} RxRingItem;
+
+/**
+ * Single-producer/single-consumer ring filled by the RX thread.
+ * The head is written only by the RX thread, the tail only by the reader.
+ */
+typedef struct
+{
+    RxRingItem items[SOCKETCAN_RX_RING_SIZE];
+    atomic_size_t head;
+    atomic_size_t tail;
+    atomic_uint_least64_t ring_overflow_count;
+    atomic_uint_least32_t kernel_drop_count;
+    atomic_size_t peak_size;
+    atomic_bool is_running;
+    const SocketCANInstance* ins;
+    pthread_t thread;
+} RxRing;
+
+static RxRing g_rx_ring;
 
 /// Returns the current errno as negated int16_t
 static int16_t getErrorCode()
@@ -72,6 +104,10 @@ int16_t socketcanInit(SocketCANInstance* out_ins, const char* can_iface_name)
     addr.can_family = AF_CAN;
     addr.can_ifindex = ifr.ifr_ifindex;
 
+    // Report the frames dropped by the kernel because the socket buffer was full
+    const int enable = 1;
+    (void)setsockopt(fd, SOL_SOCKET, SO_RXQ_OVFL, &enable, sizeof(enable));
+
     const int bind_result = bind(fd, (struct sockaddr*)&addr, sizeof(addr));
     if (bind_result < 0)
     {
@@ -130,11 +166,18 @@ int16_t socketcanTransmit(SocketCANInstance* ins, const CanardCANFrame* frame, i
     return 1;
 }
 
-int16_t socketcanReceive(SocketCANInstance* ins, CanardCANFrame* out_frame, int32_t timeout_msec)
+uint64_t socketcanGetMonotonicUsec(void)
+{
+    struct timespec ts;
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000ULL;
+}
+
+static int16_t readFrame(int fd, CanardCANFrame* out_frame, uint64_t* out_timestamp_usec, int32_t timeout_msec)
 {
     struct pollfd fds;
     memset(&fds, 0, sizeof(fds));
-    fds.fd = ins->fd;
+    fds.fd = fd;
     fds.events |= POLLIN;
 
     const int poll_result = poll(&fds, 1, timeout_msec);
@@ -152,7 +195,16 @@ int16_t socketcanReceive(SocketCANInstance* ins, CanardCANFrame* out_frame, int3
     }
 
     struct can_frame receive_frame;
-    const ssize_t nbytes = read(ins->fd, &receive_frame, sizeof(receive_frame));
+    struct iovec iov = { .iov_base = &receive_frame, .iov_len = sizeof(receive_frame) };
+    uint8_t control[CMSG_SPACE(sizeof(uint32_t))];
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+
+    const ssize_t nbytes = recvmsg(fd, &msg, 0);
     if (nbytes < 0)
     {
         return getErrorCode();
@@ -167,13 +219,164 @@ int16_t socketcanReceive(SocketCANInstance* ins, CanardCANFrame* out_frame, int3
         return -EIO;
     }
 
+    for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg != NULL; cmsg = CMSG_NXTHDR(&msg, cmsg))
+    {
+        if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SO_RXQ_OVFL)
+        {
+            uint32_t kernel_drop_count;
+            memcpy(&kernel_drop_count, CMSG_DATA(cmsg), sizeof(kernel_drop_count));
+            atomic_store_explicit(&g_rx_ring.kernel_drop_count, kernel_drop_count, memory_order_relaxed);
+        }
+    }
+
     out_frame->id = receive_frame.can_id;               // TODO: Map flags properly
     out_frame->data_len = receive_frame.can_dlc;
+    out_frame->iface_id = 0;
     memcpy(out_frame->data, &receive_frame.data, receive_frame.can_dlc);
+    if (out_timestamp_usec != NULL)
+    {
+        *out_timestamp_usec = socketcanGetMonotonicUsec();
+    }
 
     return 1;
 }
 
+static void* rxThread(void* arg)
+{
+    const SocketCANInstance* ins = (const SocketCANInstance*)arg;
+    RxRing* ring = &g_rx_ring;
+
+    // The read timeout lets the thread notice socketcanStopRxThread
+    while (atomic_load_explicit(&ring->is_running, memory_order_relaxed))
+    {
+        RxRingItem received;
+        const int16_t res = readFrame(ins->fd, &received.frame, &received.timestamp_usec, 100);
+        if (res < 0)
+        {
+            const struct timespec delay = { .tv_sec = 0, .tv_nsec = 1000000 };
+            (void)nanosleep(&delay, NULL);
+        }
+        if (res <= 0)
+        {
+            continue;
+        }
+
+        const size_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+        const size_t size = head - atomic_load_explicit(&ring->tail, memory_order_acquire);
+        if (size >= SOCKETCAN_RX_RING_SIZE)
+        {
+            atomic_fetch_add_explicit(&ring->ring_overflow_count, 1, memory_order_relaxed);
+            continue;
+        }
+
+        ring->items[head & (SOCKETCAN_RX_RING_SIZE - 1U)] = received;
+        if (size + 1U > atomic_load_explicit(&ring->peak_size, memory_order_relaxed))
+        {
+            atomic_store_explicit(&ring->peak_size, size + 1U, memory_order_relaxed);
+        }
+        atomic_store_explicit(&ring->head, head + 1U, memory_order_release);
+    }
+
+    return NULL;
+}
+
+static bool popFrame(RxRing* ring, CanardCANFrame* out_frame, uint64_t* out_timestamp_usec)
+{
+    const size_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    if (tail == atomic_load_explicit(&ring->head, memory_order_acquire))
+    {
+        return false;
+    }
+
+    const RxRingItem* item = &ring->items[tail & (SOCKETCAN_RX_RING_SIZE - 1U)];
+    *out_frame = item->frame;
+    if (out_timestamp_usec != NULL)
+    {
+        *out_timestamp_usec = item->timestamp_usec;
+    }
+    atomic_store_explicit(&ring->tail, tail + 1U, memory_order_release);
+    return true;
+}
+
+int16_t socketcanReceive(SocketCANInstance* ins, CanardCANFrame* out_frame, int32_t timeout_msec)
+{
+    return socketcanReceiveTimestamped(ins, out_frame, NULL, timeout_msec);
+}
+
+int16_t socketcanReceiveTimestamped(SocketCANInstance* ins,
+                                    CanardCANFrame* out_frame,
+                                    uint64_t* out_timestamp_usec,
+                                    int32_t timeout_msec)
+{
+    if (!atomic_load_explicit(&g_rx_ring.is_running, memory_order_acquire) || g_rx_ring.ins != ins)
+    {
+        return readFrame(ins->fd, out_frame, out_timestamp_usec, timeout_msec);
+    }
+
+    const uint64_t deadline_usec = socketcanGetMonotonicUsec() + (uint64_t)timeout_msec * 1000ULL;
+    while (!popFrame(&g_rx_ring, out_frame, out_timestamp_usec))
+    {
+        if (timeout_msec == 0 || (timeout_msec > 0 && socketcanGetMonotonicUsec() >= deadline_usec))
+        {
+            return 0;
+        }
+        const struct timespec delay = { .tv_sec = 0, .tv_nsec = 100000 };
+        (void)nanosleep(&delay, NULL);
+    }
+
+    return 1;
+}
+
+int16_t socketcanStartRxThread(SocketCANInstance* ins)
+{
+    RxRing* ring = &g_rx_ring;
+    if (atomic_load_explicit(&ring->is_running, memory_order_acquire))
+    {
+        return -EBUSY;
+    }
+
+    atomic_store_explicit(&ring->head, 0, memory_order_relaxed);
+    atomic_store_explicit(&ring->tail, 0, memory_order_relaxed);
+    atomic_store_explicit(&ring->peak_size, 0, memory_order_relaxed);
+    ring->ins = ins;
+    atomic_store_explicit(&ring->is_running, true, memory_order_release);
+
+    const int res = pthread_create(&ring->thread, NULL, rxThread, ins);
+    if (res != 0)
+    {
+        atomic_store_explicit(&ring->is_running, false, memory_order_release);
+        return (int16_t)-res;
+    }
+
+    return 0;
+}
+
+int16_t socketcanStopRxThread(SocketCANInstance* ins)
+{
+    RxRing* ring = &g_rx_ring;
+    if (!atomic_load_explicit(&ring->is_running, memory_order_acquire) || ring->ins != ins)
+    {
+        return -EINVAL;
+    }
+
+    atomic_store_explicit(&ring->is_running, false, memory_order_release);
+    const int res = pthread_join(ring->thread, NULL);
+    ring->ins = NULL;
+    return (int16_t)-res;
+}
+
+SocketCANRxStats socketcanGetRxStats(void)
+{
+    const RxRing* ring = &g_rx_ring;
+    SocketCANRxStats stats;
+    stats.ring_size = atomic_load_explicit(&ring->head, memory_order_acquire) -
+                      atomic_load_explicit(&ring->tail, memory_order_acquire);
+    stats.ring_peak_size = atomic_load_explicit(&ring->peak_size, memory_order_relaxed);
+    stats.ring_overflow_count = atomic_load_explicit(&ring->ring_overflow_count, memory_order_relaxed);
+    stats.kernel_drop_count = atomic_load_explicit(&ring->kernel_drop_count, memory_order_relaxed);
+    return stats;
+}
+
 int socketcanGetSocketFileDescriptor(const SocketCANInstance* ins)
 {
     return ins->fd;
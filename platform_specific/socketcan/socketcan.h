@@ -15,11 +15,24 @@ extern "C"
 {
 #endif
 
+/// The capacity of the RX thread ring in frames, must be a power of two
+#ifndef SOCKETCAN_RX_RING_SIZE
+# define SOCKETCAN_RX_RING_SIZE     256
+#endif
+
 typedef struct
 {
     int fd;
 } SocketCANInstance;
 
+typedef struct
+{
+    size_t ring_size;                   ///< Number of frames waiting in the RX thread ring
+    size_t ring_peak_size;              ///< Maximum number of frames in the ring since the thread start
+    uint64_t ring_overflow_count;       ///< Number of frames dropped because the ring was full
+    uint32_t kernel_drop_count;         ///< Number of frames dropped because the socket buffer was full
+} SocketCANRxStats;
+
 /**
  * Initializes the SocketCAN instance.
  * Returns 0 on success, negative on error.
@@ -46,6 +59,39 @@ int16_t socketcanTransmit(SocketCANInstance* ins, const CanardCANFrame* frame, i
  */
 int16_t socketcanReceive(SocketCANInstance* ins, CanardCANFrame* out_frame, int32_t timeout_msec);
 
+/**
+ * Same as socketcanReceive, also returns the monotonic time of the frame arrival in microseconds.
+ * With the RX thread running, the arrival time is the time the RX thread read the frame from the socket.
+ */
+int16_t socketcanReceiveTimestamped(SocketCANInstance* ins,
+                                    CanardCANFrame* out_frame,
+                                    uint64_t* out_timestamp_usec,
+                                    int32_t timeout_msec);
+
+/**
+ * Returns the monotonic time in microseconds, the clock of the socketcanReceiveTimestamped timestamps.
+ */
+uint64_t socketcanGetMonotonicUsec(void);
+
+/**
+ * Starts a thread that drains the CAN socket into a lock-free ring as soon as the frames arrive,
+ * so the frames are not lost while the application doesn't receive. Only one instance can have the thread.
+ * After the start, socketcanReceive reads the ring and should be called from one thread only.
+ * Returns 0 on success, negative on error.
+ */
+int16_t socketcanStartRxThread(SocketCANInstance* ins);
+
+/**
+ * Stops the RX thread. The frames left in the ring are discarded.
+ * Returns 0 on success, negative on error.
+ */
+int16_t socketcanStopRxThread(SocketCANInstance* ins);
+
+/**
+ * Returns the RX ring fill level and the numbers of lost frames.
+ */
+SocketCANRxStats socketcanGetRxStats(void);
+
 /**
  * Returns the file descriptor of the CAN socket.
  * Can be used for external IO multiplexing.
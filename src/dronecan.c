@@ -13,6 +13,9 @@
 #include "libdcnode/uavcan/protocol/param/execute_opcode.h"
 #include "libdcnode/uavcan/protocol/param/getset.h"
 #include "libdcnode/can_driver.h"
+#if DRONECAN_PUBLISH_QUEUE_SIZE > 0
+#include <stdatomic.h>
+#endif
 
 #ifndef MAX_PARAM_NAME_LENGTH
     #define MAX_PARAM_NAME_LENGTH       32
@@ -22,6 +25,50 @@
     #define CANARD_BUFFER_SIZE          1024
 #endif
 
+#if DRONECAN_STATIC_BINDING
+    #define PLATFORM_REQUEST_RESTART()                  platformSpecificRequestRestart()
+    #define PLATFORM_READ_UNIQUE_ID(uid)                platformSpecificReadUniqueID(uid)
+    #define CAN_INIT(speed, idx)                        canDriverInit(speed, idx)
+    #define CAN_RECV(frame, timestamp, idx)             canDriverReceiveTimestamped(frame, timestamp, idx)
+    #define CAN_SEND(frame, idx)                        canDriverTransmit(frame, idx)
+    #define CAN_GET_ERROR_COUNT()                       canDriverGetErrorCount()
+    #define PARAMS_GET_NAME(idx)                        paramsGetName(idx)
+    #define PARAMS_IS_INTEGER(idx)                      paramsIsInteger(idx)
+    #define PARAMS_IS_STRING(idx)                       paramsIsString(idx)
+    #define PARAMS_FIND(name, len)                      paramsFind(name, len)
+    #define PARAMS_SAVE()                               paramsSave()
+    #define PARAMS_RESET_TO_DEFAULT()                   paramsResetToDefault()
+    #define PARAMS_SET_INTEGER_VALUE(idx, value)        paramsSetIntegerValue(idx, value)
+    #define PARAMS_GET_INTEGER_VALUE(idx)               paramsGetIntegerValue(idx)
+    #define PARAMS_GET_INTEGER_MIN(idx)                 paramsGetIntegerMin(idx)
+    #define PARAMS_GET_INTEGER_MAX(idx)                 paramsGetIntegerMax(idx)
+    #define PARAMS_GET_INTEGER_DEF(idx)                 paramsGetIntegerDef(idx)
+    #define PARAMS_SET_STRING_VALUE(idx, len, value)    paramsSetStringValue(idx, len, value)
+    #define PARAMS_GET_STRING_VALUE(idx)                paramsGetStringValue(idx)
+#else
+    #define PLATFORM_REQUEST_RESTART()                  platform.requestRestart()
+    #define PLATFORM_READ_UNIQUE_ID(uid)                platform.readUniqueId(uid)
+    #define CAN_INIT(speed, idx)                        platform.can.init(speed, idx)
+    #define CAN_RECV(frame, timestamp, idx)             (platform.can.recvTimestamped != NULL ? \
+                                                        platform.can.recvTimestamped(frame, timestamp, idx) : \
+                                                        platform.can.recv(frame, idx))
+    #define CAN_SEND(frame, idx)                        platform.can.send(frame, idx)
+    #define CAN_GET_ERROR_COUNT()                       platform.can.getErrorCount()
+    #define PARAMS_GET_NAME(idx)                        params.getName(idx)
+    #define PARAMS_IS_INTEGER(idx)                      params.isInteger(idx)
+    #define PARAMS_IS_STRING(idx)                       params.isString(idx)
+    #define PARAMS_FIND(name, len)                      params.find(name, len)
+    #define PARAMS_SAVE()                               params.save()
+    #define PARAMS_RESET_TO_DEFAULT()                   params.resetToDefault()
+    #define PARAMS_SET_INTEGER_VALUE(idx, value)        params.integer.setValue(idx, value)
+    #define PARAMS_GET_INTEGER_VALUE(idx)               params.integer.getValue(idx)
+    #define PARAMS_GET_INTEGER_MIN(idx)                 params.integer.getMin(idx)
+    #define PARAMS_GET_INTEGER_MAX(idx)                 params.integer.getMax(idx)
+    #define PARAMS_GET_INTEGER_DEF(idx)                 params.integer.getDef(idx)
+    #define PARAMS_SET_STRING_VALUE(idx, len, value)    params.string.setValue(idx, len, value)
+    #define PARAMS_GET_STRING_VALUE(idx)                params.string.getValue(idx)
+#endif
+
 
 /**
   * @brief Encapsulate everything required for a subscriber
@@ -30,20 +77,27 @@ typedef struct {
     uint64_t signature;
     void (*callback)(CanardRxTransfer* transfer);
     uint16_t id;
+    bool enabled;
+    uint32_t allowed_source_nodes[DRONECAN_NODE_SET_WORDS];
 } Subscriber_t;
 #if UINTPTR_MAX == 0xFFFFFFFF
-static_assert(sizeof(Subscriber_t) == 16, "Subscriber_t size mismatch on 32-bit");
+static_assert(sizeof(Subscriber_t) == 32, "Subscriber_t size mismatch on 32-bit");
 #elif UINTPTR_MAX == 0xFFFFFFFFFFFFFFFF
-static_assert(sizeof(Subscriber_t) == 24, "Subscriber_t size mismatch on 64-bit");
+static_assert(sizeof(Subscriber_t) == 40, "Subscriber_t size mismatch on 64-bit");
 #else
 #error "Unknown pointer size or unsupported platform"
 #endif
 
+// Rounded up to keep the instance layout independent of the number of subscribers
+#define ACTIVE_SUBS_CAPACITY    ((DRONECAN_MAX_SUBS_NUMBER + 7) & ~7)
+
 typedef struct {
     CanardInstance g_canard;
     uint8_t buffer[CANARD_BUFFER_SIZE];
     Subscriber_t subscribers[DRONECAN_MAX_SUBS_NUMBER];
+    uint8_t active_subs[ACTIVE_SUBS_CAPACITY];  ///< enabled sub ids in ascending order
     uint8_t number_of_subs;
+    uint8_t number_of_active_subs;
     bool id_duplication_detected;
 
     // uavcan.protocol.NodeStatus
@@ -62,16 +116,158 @@ typedef struct {
 } DronecanNodeInstance;
 
 #if UINTPTR_MAX == 0xFFFFFFFF
-#define INSTANCE_SIZE (208 + CANARD_BUFFER_SIZE + DRONECAN_MAX_SUBS_NUMBER * sizeof(Subscriber_t))
+#define INSTANCE_SIZE (208 + CANARD_BUFFER_SIZE + DRONECAN_MAX_SUBS_NUMBER * sizeof(Subscriber_t) + ACTIVE_SUBS_CAPACITY)
 #elif UINTPTR_MAX == 0xFFFFFFFFFFFFFFFF
-#define INSTANCE_SIZE (256 + CANARD_BUFFER_SIZE + DRONECAN_MAX_SUBS_NUMBER * sizeof(Subscriber_t))
+#define INSTANCE_SIZE (256 + CANARD_BUFFER_SIZE + DRONECAN_MAX_SUBS_NUMBER * sizeof(Subscriber_t) + ACTIVE_SUBS_CAPACITY)
 #else
 #error "Unknown pointer size or unsupported platform"
 #endif
 static_assert(sizeof(DronecanNodeInstance) == INSTANCE_SIZE);
 
+/**
+  * @brief A subscription with a frame-by-frame decoder. Its transfers bypass the libcanard reassembly,
+  * so only one transfer per subscription can be received at a time.
+  */
+typedef struct {
+    uint64_t signature;
+    const UavcanStreamCallbacks* callbacks;
+    uint16_t id;
+
+    bool is_active;
+    uint8_t source_node_id;
+    uint8_t transfer_id;
+    uint8_t next_toggle;
+    uint16_t crc;
+    uint16_t expected_crc;
+    CanardRxTransfer transfer;
+} StreamSubscriber_t;
+
+typedef struct {
+    StreamSubscriber_t subscribers[DRONECAN_MAX_STREAM_SUBS_NUMBER];
+    uint8_t number_of_subs;
+} DronecanStreams;
+
+#if DRONECAN_PUBLISH_QUEUE_SIZE > 0
+static_assert((DRONECAN_PUBLISH_QUEUE_SIZE & (DRONECAN_PUBLISH_QUEUE_SIZE - 1)) == 0,
+              "DRONECAN_PUBLISH_QUEUE_SIZE must be a power of two");
+static_assert(DRONECAN_PUBLISH_QUEUE_SIZE >= 2,
+              "DRONECAN_PUBLISH_QUEUE_SIZE must be at least 2 for the lap sequences of the slots");
+#define PUBLISH_QUEUE_MASK      ((size_t)DRONECAN_PUBLISH_QUEUE_SIZE - 1)
+
+/**
+  * @brief A slot of the bounded MPSC publish queue. Its sequence is relative to the start of the lap:
+  * a slot of the lap that begins at the position `lap` is free when sequence == lap,
+  * it is filled when sequence == lap + 1. The zero-initialized queue is ready to use.
+  */
+typedef struct {
+    atomic_size_t sequence;
+    uint64_t signature;
+    uint16_t id;
+    uint16_t payload_len;
+    uint8_t transfer_id;
+    uint8_t priority;
+    uint8_t payload[DRONECAN_PUBLISH_QUEUE_PAYLOAD_SIZE];
+} PublishSlot_t;
+
+typedef struct {
+    PublishSlot_t slots[DRONECAN_PUBLISH_QUEUE_SIZE];
+    atomic_size_t enqueue_pos;      ///< shared by the producers
+    size_t dequeue_pos;             ///< owned by the uavcanSpinOnce thread
+    atomic_uint_least32_t number_of_drops;
+} DronecanPublishQueue;
+
+static DronecanPublishQueue publish_queue = {};
+#endif
+
+/**
+  * @brief A single-frame subscription dispatched from the CAN RX interrupt.
+  * Its multi-frame transfers are reassembled by libcanard, which needs the signature for the CRC.
+  */
+typedef struct {
+    void (*callback)(CanardRxTransfer* transfer);
+    uint64_t signature;
+    uint16_t id;
+} FastSubscriber_t;
+
+typedef struct {
+    FastSubscriber_t subscribers[DRONECAN_MAX_FAST_SUBS_NUMBER];
+    volatile uint8_t number_of_subs;
+    volatile uint32_t number_of_fallbacks;  ///< multi-frame transfers passed to uavcanSpinOnce
+} DronecanFastSubs;
+
+#define RX_FRAMES_PER_SPIN      10U     ///< frames dispatched by one uavcanSpinOnce
+
+#if DRONECAN_RX_STAGING_SIZE > 0
+static_assert(DRONECAN_RX_STAGING_SIZE <= 128, "DRONECAN_RX_STAGING_SIZE is too big");
+
+typedef struct {
+    CanardCANFrame frame;
+    uint64_t timestamp_usec;
+    uint32_t sequence;      ///< keeps the arrival order of the frames with the same CAN ID
+} StagedFrame_t;
+#endif
+
+/**
+  * @brief Received frames waiting for dispatch in the order of CAN ID priority
+  */
+typedef struct {
+#if DRONECAN_RX_STAGING_SIZE > 0
+    StagedFrame_t frames[DRONECAN_RX_STAGING_SIZE];
+    uint32_t next_sequence;
+    uint16_t sheddable_types[DRONECAN_MAX_SHEDDABLE_TYPES];
+    uint8_t number_of_sheddable_types;
+#endif
+    UavcanRxStagingStats stats;
+} DronecanRxStaging;
+
+/**
+  * @brief A request sent by uavcanRequest. It is matched with the response by
+  * (server_node_id, id, transfer_id). An entry with NULL callback is free.
+  */
+typedef struct {
+    uint64_t signature;
+    UavcanResponseCallback callback;
+    void* user_data;
+    uint32_t deadline_ms;
+    uint16_t id;
+    uint8_t server_node_id;
+    uint8_t transfer_id;
+} PendingRequest_t;
+
+typedef struct {
+    PendingRequest_t requests[DRONECAN_MAX_PENDING_REQUESTS];
+    uint8_t number_of_requests;
+    uint8_t next_transfer_id;
+} DronecanClient;
+
+/**
+  * @brief uavcan.protocol.param.ExecuteOpcode request waiting for the background save or reset
+  */
+typedef struct {
+    UavcanResponseToken token;
+    bool is_pending;
+} PendingParamsOperation;
+
+/**
+  * @brief Data types whose RX states are released by uavcanSpinOnce after the reception.
+  * A subscription may be disabled from a callback, while libcanard still uses the RX state of the transfer,
+  * so only the data type of the transfer being delivered is deferred, the others are released immediately.
+  */
+typedef struct {
+    uint16_t ids[DRONECAN_MAX_SUBS_NUMBER];
+    uint8_t size;
+    bool is_delivering;
+    uint16_t delivering_id;
+} DronecanRxStatesRelease;
+
 static DronecanNodeInstance node = {};
+static DronecanStreams streams = {};
+static DronecanFastSubs fast_subs = {};
+static DronecanRxStaging rx_staging = {};
 static ParamsApi params = {};
+static PendingParamsOperation pending_params_operation = {};
+static DronecanClient client = {};
+static DronecanRxStatesRelease rx_states_release = {};
 PlatformApi platform = {};
 
 static bool shouldAcceptTransfer(const CanardInstance* ins,
@@ -80,9 +276,19 @@ static bool shouldAcceptTransfer(const CanardInstance* ins,
                                  CanardTransferType transfer_type,
                                  uint8_t source_node_id);
 static void onTransferReceived(CanardInstance* ins, CanardRxTransfer* transfer);
+static void uavcanProcessPublishQueue();
 static uint8_t uavcanProcessSending();
+static bool uavcanStreamHandleFrame(const CanardCANFrame* frame, uint64_t timestamp_usec);
 static bool uavcanProcessReceiving();
+static void uavcanDispatchFrame(const CanardCANFrame* frame, uint64_t timestamp_usec);
 static void uavcanSpinNodeStatus();
+static const FastSubscriber_t* uavcanFindFastSubscriber(uint16_t data_type_id);
+static PendingRequest_t* uavcanFindPendingRequest(uint8_t server_node_id, uint16_t id, uint8_t transfer_id);
+static void uavcanSpinPendingRequests(uint32_t now_ms);
+static bool uavcanIsValidSubId(int8_t sub_id);
+static void uavcanScheduleRxStatesRelease(uint16_t data_type_id);
+static void uavcanReleaseRxStatesIfUnused(uint16_t data_type_id);
+static void uavcanReleaseUnusedRxStates();
 
 static void uavcanProtocolGetNodeInfoHandle(CanardRxTransfer* transfer);
 static void uavcanProtocolParamGetSetHandle(CanardRxTransfer* transfer);
@@ -104,7 +310,7 @@ int16_t uavcanInitApplication(ParamsApi params_api, PlatformApi platform_api, co
     params = params_api;
     platform = platform_api;
 
-    int16_t res = platform.can.init(1000000, CAN_DRIVER_FIRST);
+    int16_t res = CAN_INIT(1000000, CAN_DRIVER_FIRST);
     if (res < 0) {
         return res;
     }
@@ -124,7 +330,7 @@ int16_t uavcanInitApplication(ParamsApi params_api, PlatformApi platform_api, co
     node.node_status.sub_mode = 0;
     node.node_status.vendor_specific_status_code = 0;
 
-    platform.readUniqueId(node.hw_version.unique_id);
+    PLATFORM_READ_UNIQUE_ID(node.hw_version.unique_id);
 
     uavcanSubscribe(UAVCAN_GET_NODE_INFO_DATA_TYPE,      uavcanProtocolGetNodeInfoHandle);
     uavcanSubscribe(UAVCAN_PROTOCOL_PARAM_GETSET,        uavcanProtocolParamGetSetHandle);
@@ -145,21 +351,222 @@ uint8_t uavcanGetNodeId() {
 }
 
 void uavcanSpinOnce() {
-    uint32_t now_ms = platform.getTimeMs();
+    uint32_t now_ms = uavcanPlatformGetTimeMs();
+    uavcanProcessPublishQueue();
     uavcanProcessSending();
     uavcanProcessReceiving(now_ms);
+    uavcanReleaseUnusedRxStates();
+    uavcanSpinPendingRequests(now_ms);
     uavcanSpinNodeStatus(now_ms);
 }
 
 int8_t uavcanSubscribe(uint64_t signature, uint16_t id, void (*callback)(CanardRxTransfer*)) {
-    if (node.number_of_subs >= DRONECAN_MAX_SUBS_NUMBER || signature == 0 || id == 0 || callback == NULL) {
+    if (signature == 0 || id == 0 || callback == NULL || uavcanFindFastSubscriber(id) != NULL) {
         return -1;
     }
 
-    node.subscribers[node.number_of_subs].signature = signature;
-    node.subscribers[node.number_of_subs].id = id;
-    node.subscribers[node.number_of_subs].callback = callback;
-    return node.number_of_subs++;
+    // Reuse a slot released by uavcanUnsubscribe, so sub ids of other subscriptions stay the same
+    uint8_t sub_idx = 0;
+    while (sub_idx < node.number_of_subs && node.subscribers[sub_idx].callback != NULL) {
+        sub_idx++;
+    }
+    if (sub_idx >= DRONECAN_MAX_SUBS_NUMBER) {
+        return -1;
+    }
+
+    Subscriber_t* sub = &node.subscribers[sub_idx];
+    sub->signature = signature;
+    sub->id = id;
+    sub->callback = callback;
+    sub->enabled = false;
+    memset(sub->allowed_source_nodes, 0xFF, DRONECAN_NODE_SET_WORDS * 4);
+    if (sub_idx == node.number_of_subs) {
+        node.number_of_subs++;
+    }
+
+    uavcanEnableSubscription(sub_idx);
+    return sub_idx;
+}
+
+int8_t uavcanUnsubscribe(int8_t sub_id) {
+    if (!uavcanIsValidSubId(sub_id)) {
+        return -1;
+    }
+
+    uavcanDisableSubscription(sub_id);
+    memset(&node.subscribers[sub_id], 0x00, sizeof(Subscriber_t));
+    while (node.number_of_subs > 0 && node.subscribers[node.number_of_subs - 1].callback == NULL) {
+        node.number_of_subs--;
+    }
+    return 0;
+}
+
+int8_t uavcanEnableSubscription(int8_t sub_id) {
+    if (!uavcanIsValidSubId(sub_id)) {
+        return -1;
+    }
+    if (node.subscribers[sub_id].enabled) {
+        return 0;
+    }
+
+    uint8_t pos = node.number_of_active_subs;
+    while (pos > 0 && node.active_subs[pos - 1] > sub_id) {
+        node.active_subs[pos] = node.active_subs[pos - 1];
+        pos--;
+    }
+    node.active_subs[pos] = sub_id;
+    node.number_of_active_subs++;
+    node.subscribers[sub_id].enabled = true;
+    return 0;
+}
+
+int8_t uavcanDisableSubscription(int8_t sub_id) {
+    if (!uavcanIsValidSubId(sub_id)) {
+        return -1;
+    }
+    if (!node.subscribers[sub_id].enabled) {
+        return 0;
+    }
+
+    uint8_t pos = 0;
+    while (node.active_subs[pos] != sub_id) {
+        pos++;
+    }
+    for (; pos + 1 < node.number_of_active_subs; pos++) {
+        node.active_subs[pos] = node.active_subs[pos + 1];
+    }
+    node.number_of_active_subs--;
+    node.subscribers[sub_id].enabled = false;
+
+    uavcanScheduleRxStatesRelease(node.subscribers[sub_id].id);
+    return 0;
+}
+
+bool uavcanIsSubscriptionEnabled(int8_t sub_id) {
+    return uavcanIsValidSubId(sub_id) && node.subscribers[sub_id].enabled;
+}
+
+int8_t uavcanSetAllowedSourceNodes(int8_t sub_id, const uint32_t allowed_nodes[DRONECAN_NODE_SET_WORDS]) {
+    if (!uavcanIsValidSubId(sub_id)) {
+        return -1;
+    }
+
+    uint32_t* subscriber_nodes = node.subscribers[sub_id].allowed_source_nodes;
+    if (allowed_nodes == NULL) {
+        memset(subscriber_nodes, 0xFF, DRONECAN_NODE_SET_WORDS * 4);
+    } else {
+        memcpy(subscriber_nodes, allowed_nodes, DRONECAN_NODE_SET_WORDS * 4);
+    }
+    return 0;
+}
+
+int8_t uavcanSubscribeStream(uint64_t signature, uint16_t id, const UavcanStreamCallbacks* callbacks) {
+    if (streams.number_of_subs >= DRONECAN_MAX_STREAM_SUBS_NUMBER || signature == 0 || id == 0 ||
+            callbacks == NULL || callbacks->on_start == NULL || callbacks->on_bytes == NULL ||
+            callbacks->on_end == NULL) {
+        return -1;
+    }
+
+    StreamSubscriber_t* sub = &streams.subscribers[streams.number_of_subs];
+    memset(sub, 0x00, sizeof(StreamSubscriber_t));
+    sub->signature = signature;
+    sub->id = id;
+    sub->callbacks = callbacks;
+    return streams.number_of_subs++;
+}
+
+int8_t uavcanSubscribeFast(uint64_t signature, uint16_t id, void (*callback)(CanardRxTransfer*)) {
+    if (fast_subs.number_of_subs >= DRONECAN_MAX_FAST_SUBS_NUMBER || signature == 0 || id == 0 ||
+            callback == NULL || uavcanFindFastSubscriber(id) != NULL) {
+        return -1;
+    }
+    // A data type is owned either by a fast subscription or by the regular ones
+    for (uint8_t idx = 0; idx < node.number_of_subs; idx++) {
+        if (node.subscribers[idx].callback != NULL && node.subscribers[idx].id == id) {
+            return -1;
+        }
+    }
+
+    uint8_t fast_sub_id = fast_subs.number_of_subs;
+    FastSubscriber_t* sub = &fast_subs.subscribers[fast_sub_id];
+    sub->signature = signature;
+    sub->id = id;
+    sub->callback = callback;
+
+    // The interrupt sees the subscription only after it is complete
+    __asm__ volatile("" ::: "memory");
+    fast_subs.number_of_subs = fast_sub_id + 1;
+    return (int8_t)fast_sub_id;
+}
+
+bool uavcanHandleFrameFromIsr(const CanardCANFrame* frame, uint64_t timestamp_usec) {
+    if (fast_subs.number_of_subs == 0 || frame == NULL || (frame->id & CANARD_CAN_FRAME_EFF) == 0 ||
+            (frame->id & (CANARD_CAN_FRAME_RTR | CANARD_CAN_FRAME_ERR)) != 0 ||
+            frame->data_len < 1 || frame->data_len > CANARD_CAN_FRAME_MAX_DATA_LEN) {
+        return false;
+    }
+
+    const uint32_t can_id = frame->id & CANARD_CAN_EXT_ID_MASK;
+    const bool is_service = (can_id >> 7U) & 0x1U;
+    if (is_service || (can_id & 0x7FU) == CANARD_BROADCAST_NODE_ID) {
+        return false;   // anonymous transfers are handled by libcanard
+    }
+
+    const uint16_t data_type_id = (can_id >> 8U) & 0xFFFFU;
+    const FastSubscriber_t* sub = uavcanFindFastSubscriber(data_type_id);
+    if (sub == NULL) {
+        return false;
+    }
+
+    const uint8_t tail_byte = frame->data[frame->data_len - 1];
+    const bool is_single_frame = IS_START_OF_TRANSFER(tail_byte) && IS_END_OF_TRANSFER(tail_byte);
+    if (!is_single_frame || TOGGLE_BIT(tail_byte)) {
+        // A multi-frame transfer is reassembled by uavcanSpinOnce and passed to the same callback
+        if (IS_START_OF_TRANSFER(tail_byte) && !IS_END_OF_TRANSFER(tail_byte)) {
+            fast_subs.number_of_fallbacks++;
+        }
+        return false;
+    }
+
+    CanardRxTransfer transfer;
+    memset(&transfer, 0x00, sizeof(CanardRxTransfer));
+    transfer.timestamp_usec = timestamp_usec;
+    transfer.payload_head = frame->data;
+    transfer.payload_len = frame->data_len - 1;
+    transfer.data_type_id = data_type_id;
+    transfer.transfer_type = CanardTransferTypeBroadcast;
+    transfer.transfer_id = tail_byte & 0x1FU;
+    transfer.priority = (can_id >> 24U) & 0x1FU;
+    transfer.source_node_id = can_id & 0x7FU;
+    transfer.sub_id = (uint8_t)(sub - fast_subs.subscribers);
+#if CANARD_ENABLE_TAO_OPTION
+    transfer.tao = true;
+#endif
+    sub->callback(&transfer);
+    return true;
+}
+
+uint32_t uavcanGetFastFallbackCount() {
+    return fast_subs.number_of_fallbacks;
+}
+
+int8_t uavcanAddSheddableType(uint16_t data_type_id) {
+#if DRONECAN_RX_STAGING_SIZE > 0
+    if (rx_staging.number_of_sheddable_types >= DRONECAN_MAX_SHEDDABLE_TYPES) {
+        return -1;
+    }
+
+    rx_staging.sheddable_types[rx_staging.number_of_sheddable_types] = data_type_id;
+    rx_staging.number_of_sheddable_types++;
+    return 0;
+#else
+    (void)data_type_id;
+    return -1;  // without the staging buffer the frames are never shed
+#endif
+}
+
+const UavcanRxStagingStats* uavcanGetRxStagingStats() {
+    return &rx_staging.stats;
 }
 
 int16_t uavcanPublish(uint64_t data_type_signature,
@@ -177,24 +584,186 @@ int16_t uavcanPublish(uint64_t data_type_signature,
                            payload_len);
 }
 
+int16_t uavcanPublishAsync(uint64_t data_type_signature,
+                           uint16_t data_type_id,
+                           uint8_t* inout_transfer_id,
+                           uint8_t priority,
+                           const void* payload,
+                           uint16_t payload_len) {
+#if DRONECAN_PUBLISH_QUEUE_SIZE > 0
+    if (inout_transfer_id == NULL || (payload == NULL && payload_len > 0) ||
+            payload_len > DRONECAN_PUBLISH_QUEUE_PAYLOAD_SIZE) {
+        return -CANARD_ERROR_INVALID_ARGUMENT;
+    }
+
+    PublishSlot_t* slot;
+    size_t pos = atomic_load_explicit(&publish_queue.enqueue_pos, memory_order_relaxed);
+    while (true) {
+        slot = &publish_queue.slots[pos & PUBLISH_QUEUE_MASK];
+        size_t seq = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+        intptr_t diff = (intptr_t)seq - (intptr_t)(pos & ~PUBLISH_QUEUE_MASK);
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&publish_queue.enqueue_pos, &pos, pos + 1,
+                                                      memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            atomic_fetch_add_explicit(&publish_queue.number_of_drops, 1, memory_order_relaxed);
+            return -CANARD_ERROR_OUT_OF_MEMORY;
+        } else {
+            pos = atomic_load_explicit(&publish_queue.enqueue_pos, memory_order_relaxed);
+        }
+    }
+
+    slot->signature = data_type_signature;
+    slot->id = data_type_id;
+    slot->transfer_id = (*inout_transfer_id)++;
+    slot->priority = priority;
+    slot->payload_len = payload_len;
+    if (payload_len > 0) {
+        memcpy(slot->payload, payload, payload_len);
+    }
+    atomic_store_explicit(&slot->sequence, (pos & ~PUBLISH_QUEUE_MASK) + 1, memory_order_release);
+    return 0;
+#else
+    (void)data_type_signature;
+    (void)data_type_id;
+    (void)inout_transfer_id;
+    (void)priority;
+    (void)payload;
+    (void)payload_len;
+    return -CANARD_ERROR_INVALID_ARGUMENT;
+#endif
+}
+
+uint32_t uavcanGetPublishQueueDropCount() {
+#if DRONECAN_PUBLISH_QUEUE_SIZE > 0
+    return atomic_load_explicit(&publish_queue.number_of_drops, memory_order_relaxed);
+#else
+    return 0;
+#endif
+}
+
+uint16_t uavcanGetFreeTxFrames() {
+    CanardPoolAllocatorStatistics stats = canardGetPoolAllocatorStatistics(&node.g_canard);
+    return stats.capacity_blocks - stats.current_usage_blocks;
+}
+
+int16_t uavcanRequest(uint64_t data_type_signature,
+                      uint16_t data_type_id,
+                      uint8_t server_node_id,
+                      uint8_t priority,
+                      const uint8_t* payload,
+                      uint16_t len,
+                      uint32_t timeout_ms,
+                      UavcanResponseCallback callback,
+                      void* user_data) {
+    if (callback == NULL || (payload == NULL && len > 0) || server_node_id == 0 || server_node_id > 127) {
+        return -CANARD_ERROR_INVALID_ARGUMENT;
+    }
+
+    PendingRequest_t* request = NULL;
+    for (uint8_t idx = 0; idx < DRONECAN_MAX_PENDING_REQUESTS; idx++) {
+        if (client.requests[idx].callback == NULL) {
+            request = &client.requests[idx];
+            break;
+        }
+    }
+    if (request == NULL) {
+        return -CANARD_ERROR_OUT_OF_MEMORY;
+    }
+
+    // One counter is shared by all services, skip the ids still waiting for the same server and type
+    uint8_t transfer_id = client.next_transfer_id;
+    for (uint8_t attempt = 0; uavcanFindPendingRequest(server_node_id, data_type_id, transfer_id) != NULL; attempt++) {
+        if (attempt >= DRONECAN_MAX_PENDING_REQUESTS) {
+            return -CANARD_ERROR_OUT_OF_MEMORY;
+        }
+        transfer_id = (transfer_id + 1) & 31U;
+    }
+
+    uint8_t inout_transfer_id = transfer_id;
+    int16_t res = canardRequestOrRespond(&node.g_canard,
+                                         server_node_id,
+                                         data_type_signature,
+                                         data_type_id,
+                                         &inout_transfer_id,
+                                         priority,
+                                         CanardRequest,
+                                         payload,
+                                         len);
+    if (res < 0) {
+        return res;
+    }
+
+    client.next_transfer_id = inout_transfer_id & 31U;
+    request->signature = data_type_signature;
+    request->callback = callback;
+    request->user_data = user_data;
+    request->deadline_ms = uavcanPlatformGetTimeMs() + timeout_ms;
+    request->id = data_type_id;
+    request->server_node_id = server_node_id;
+    request->transfer_id = transfer_id;
+    client.number_of_requests++;
+    return 0;
+}
+
+uint8_t uavcanGetNumberOfPendingRequests() {
+    return client.number_of_requests;
+}
+
 void uavcanRespond(CanardRxTransfer* transfer,
                    uint64_t data_type_signature,
                    uint16_t data_type_id,
                    const uint8_t* payload,
                    uint16_t len) {
-    if (!transfer || !payload || len == 0) {
+    if (!transfer) {
         return;
     }
 
-    canardRequestOrRespond(&node.g_canard,
-                           transfer->source_node_id,
-                           data_type_signature,
-                           data_type_id,
-                           &transfer->transfer_id,
-                           transfer->priority,
-                           CanardResponse,
-                           payload,
-                           len);
+    UavcanResponseToken token = uavcanDeferResponse(transfer);
+    uavcanRespondDeferred(&token, data_type_signature, data_type_id, payload, len);
+}
+
+UavcanResponseToken uavcanDeferResponse(const CanardRxTransfer* transfer) {
+    UavcanResponseToken token = {
+        .source_node_id = transfer->source_node_id,
+        .transfer_id = transfer->transfer_id,
+        .priority = transfer->priority,
+    };
+    return token;
+}
+
+int16_t uavcanRespondDeferred(const UavcanResponseToken* token,
+                              uint64_t data_type_signature,
+                              uint16_t data_type_id,
+                              const uint8_t* payload,
+                              uint16_t len) {
+    if (!token || !payload || len == 0) {
+        return -CANARD_ERROR_INVALID_ARGUMENT;
+    }
+
+    uint8_t transfer_id = token->transfer_id;
+    return canardRequestOrRespond(&node.g_canard,
+                                  token->source_node_id,
+                                  data_type_signature,
+                                  data_type_id,
+                                  &transfer_id,
+                                  token->priority,
+                                  CanardResponse,
+                                  payload,
+                                  len);
+}
+
+void uavcanParamsCompleteOperation(int8_t result) {
+    if (!pending_params_operation.is_pending) {
+        return;
+    }
+    pending_params_operation.is_pending = false;
+
+    uint8_t opcode_buffer[7];
+    uavcanProtocolParamExecuteOpcodeEncode(opcode_buffer, (result < 0) ? 0 : 1);
+    uavcanRespondDeferred(&pending_params_operation.token, UAVCAN_PROTOCOL_PARAM_EXECUTEOPCODE, opcode_buffer, 7);
 }
 
 void uavcanConfigure(const SoftwareVersion* new_sw_vers, const HardwareVersion* new_hw_vers) {
@@ -228,7 +797,7 @@ void uavcanStatsIncreaseUartRx(uint32_t num) {
     node.iface_stats.can_iface_stats[0].frames_rx += num;
 }
 uint64_t uavcanGetErrorCount() {
-    return platform.can.getErrorCount();
+    return CAN_GET_ERROR_COUNT();
 }
 
 void uavcanSetNodeHealth(NodeStatusHealth_t health) {
@@ -269,11 +838,36 @@ const NodeStatus_t* uavcanGetNodeStatus() {
 static bool shouldAcceptTransfer(__attribute__((unused)) const CanardInstance* ins,
                                  uint64_t* out_data_type_signature,
                                  uint16_t data_type_id,
-                                 __attribute__((unused)) CanardTransferType transfer_type,
-                                 __attribute__((unused)) uint8_t source_node_id) {
-    for (uint8_t sub_idx = 0; sub_idx < node.number_of_subs; sub_idx++) {
-        if (data_type_id == node.subscribers[sub_idx].id) {
-            *out_data_type_signature = node.subscribers[sub_idx].signature;
+                                 CanardTransferType transfer_type,
+                                 uint8_t source_node_id) {
+    // A transfer rejected here costs neither RX state memory nor CRC calculation
+    if (transfer_type == CanardTransferTypeResponse) {
+        // The transfer id is not known yet, so accept a response from any outstanding request to this server.
+        // The subscriptions receive only requests and messages, so the other responses are dropped.
+        for (uint8_t idx = 0; idx < DRONECAN_MAX_PENDING_REQUESTS && client.number_of_requests > 0; idx++) {
+            const PendingRequest_t* request = &client.requests[idx];
+            if (request->callback != NULL && request->id == data_type_id &&
+                    request->server_node_id == source_node_id) {
+                *out_data_type_signature = request->signature;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    for (uint8_t idx = 0; idx < node.number_of_active_subs; idx++) {
+        const Subscriber_t* sub = &node.subscribers[node.active_subs[idx]];
+        if (data_type_id == sub->id && uavcanNodeSetContains(sub->allowed_source_nodes, source_node_id)) {
+            *out_data_type_signature = sub->signature;
+            return true;
+        }
+    }
+
+    // The multi-frame transfers of the fast subscriptions, see uavcanHandleFrameFromIsr
+    if (transfer_type == CanardTransferTypeBroadcast && source_node_id != CANARD_BROADCAST_NODE_ID) {
+        const FastSubscriber_t* fast_sub = uavcanFindFastSubscriber(data_type_id);
+        if (fast_sub != NULL) {
+            *out_data_type_signature = fast_sub->signature;
             return true;
         }
     }
@@ -287,12 +881,180 @@ static bool shouldAcceptTransfer(__attribute__((unused)) const CanardInstance* i
   */
 static void onTransferReceived(__attribute__((unused)) CanardInstance* ins,
                                CanardRxTransfer* transfer) {
-    for (uint8_t sub_idx = 0; sub_idx < node.number_of_subs; sub_idx++) {
-        if (transfer->data_type_id == node.subscribers[sub_idx].id) {
+    if (transfer->transfer_type == CanardTransferTypeResponse) {
+        PendingRequest_t* request = uavcanFindPendingRequest(transfer->source_node_id,
+                                                             transfer->data_type_id,
+                                                             transfer->transfer_id);
+        if (request != NULL) {
+            // Release the entry first, so the callback may send the next request
+            PendingRequest_t completed = *request;
+            request->callback = NULL;
+            client.number_of_requests--;
+            completed.callback(transfer, completed.server_node_id, completed.user_data);
+        }
+        return;     // a late, duplicate or unexpected response
+    }
+
+    // A callback may unsubscribe or disable subscriptions, so iterate over a copy of the active list
+    uint8_t active_subs[DRONECAN_MAX_SUBS_NUMBER];
+    const uint8_t number_of_active_subs = node.number_of_active_subs;
+    memcpy(active_subs, node.active_subs, number_of_active_subs);
+    rx_states_release.is_delivering = true;
+    rx_states_release.delivering_id = transfer->data_type_id;
+
+    for (uint8_t idx = 0; idx < number_of_active_subs; idx++) {
+        const uint8_t sub_idx = active_subs[idx];
+        const Subscriber_t* sub = &node.subscribers[sub_idx];
+        if (sub->enabled && transfer->data_type_id == sub->id &&
+                uavcanNodeSetContains(sub->allowed_source_nodes, transfer->source_node_id)) {
             transfer->sub_id = sub_idx;
-            node.subscribers[sub_idx].callback(transfer);
+            sub->callback(transfer);
+        }
+    }
+
+    if (transfer->transfer_type == CanardTransferTypeBroadcast &&
+            transfer->source_node_id != CANARD_BROADCAST_NODE_ID) {
+        const FastSubscriber_t* fast_sub = uavcanFindFastSubscriber(transfer->data_type_id);
+        if (fast_sub != NULL) {
+            transfer->sub_id = (uint8_t)(fast_sub - fast_subs.subscribers);
+            fast_sub->callback(transfer);
+        }
+    }
+    rx_states_release.is_delivering = false;
+}
+
+/**
+  * @brief Called from the RX interrupt as well, so it reads only the fast subscriptions table
+  */
+static const FastSubscriber_t* uavcanFindFastSubscriber(uint16_t data_type_id) {
+    const uint8_t number_of_subs = fast_subs.number_of_subs;
+    for (uint8_t idx = 0; idx < number_of_subs; idx++) {
+        if (fast_subs.subscribers[idx].id == data_type_id) {
+            return &fast_subs.subscribers[idx];
+        }
+    }
+    return NULL;
+}
+
+static PendingRequest_t* uavcanFindPendingRequest(uint8_t server_node_id, uint16_t id, uint8_t transfer_id) {
+    for (uint8_t idx = 0; idx < DRONECAN_MAX_PENDING_REQUESTS; idx++) {
+        PendingRequest_t* request = &client.requests[idx];
+        if (request->callback != NULL && request->id == id &&
+                request->server_node_id == server_node_id && request->transfer_id == transfer_id) {
+            return request;
         }
     }
+    return NULL;
+}
+
+/**
+  * @brief Report the expired requests to their callbacks with NULL transfer
+  */
+static void uavcanSpinPendingRequests(uint32_t now_ms) {
+    for (uint8_t idx = 0; idx < DRONECAN_MAX_PENDING_REQUESTS && client.number_of_requests > 0; idx++) {
+        PendingRequest_t* request = &client.requests[idx];
+        if (request->callback == NULL || (int32_t)(now_ms - request->deadline_ms) < 0) {
+            continue;
+        }
+
+        PendingRequest_t expired = *request;
+        request->callback = NULL;
+        client.number_of_requests--;
+        expired.callback(NULL, expired.server_node_id, expired.user_data);
+    }
+}
+
+static bool uavcanIsValidSubId(int8_t sub_id) {
+    return sub_id >= 0 && sub_id < node.number_of_subs && node.subscribers[sub_id].callback != NULL;
+}
+
+/**
+  * @brief Release the RX states of a data type, or defer it until the end of the reception
+  * when the data type is the one of the transfer being delivered
+  */
+static void uavcanScheduleRxStatesRelease(uint16_t data_type_id) {
+    if (!rx_states_release.is_delivering || rx_states_release.delivering_id != data_type_id) {
+        uavcanReleaseRxStatesIfUnused(data_type_id);
+        return;
+    }
+
+    for (uint8_t idx = 0; idx < rx_states_release.size; idx++) {
+        if (rx_states_release.ids[idx] == data_type_id) {
+            return;
+        }
+    }
+    if (rx_states_release.size >= DRONECAN_MAX_SUBS_NUMBER) {
+        // The listed transfers are already delivered, so their states are safe to release now
+        uavcanReleaseUnusedRxStates();
+    }
+    rx_states_release.ids[rx_states_release.size] = data_type_id;
+    rx_states_release.size++;
+}
+
+/**
+  * @brief Release the request and broadcast RX states that no enabled subscription uses.
+  * The broadcast states of the fast subscriptions are kept, the response states belong to the client.
+  */
+static void uavcanReleaseRxStatesIfUnused(uint16_t data_type_id) {
+    for (uint8_t idx = 0; idx < node.number_of_active_subs; idx++) {
+        if (node.subscribers[node.active_subs[idx]].id == data_type_id) {
+            return;
+        }
+    }
+    canardReleaseRxStates(&node.g_canard, data_type_id, CanardTransferTypeRequest);
+    if (uavcanFindFastSubscriber(data_type_id) == NULL) {
+        canardReleaseRxStates(&node.g_canard, data_type_id, CanardTransferTypeBroadcast);
+    }
+}
+
+/**
+  * @brief Release the deferred RX states. Called by uavcanSpinOnce after the reception,
+  * when libcanard no longer uses the RX states.
+  */
+static void uavcanReleaseUnusedRxStates() {
+    uint8_t size = rx_states_release.size;
+    rx_states_release.size = 0;
+    for (uint8_t idx = 0; idx < size; idx++) {
+        uavcanReleaseRxStatesIfUnused(rx_states_release.ids[idx]);
+    }
+}
+
+/**
+  * @brief Move the transfers submitted by uavcanPublishAsync into the TX queue.
+  * At most one queue length is moved per call, so busy producers can't stall the spin.
+  * When the TX queue is full, the transfers stay in the publish queue until the next call.
+  */
+static void uavcanProcessPublishQueue() {
+#if DRONECAN_PUBLISH_QUEUE_SIZE > 0
+    for (size_t idx = 0; idx < DRONECAN_PUBLISH_QUEUE_SIZE; idx++) {
+        size_t pos = publish_queue.dequeue_pos;
+        PublishSlot_t* slot = &publish_queue.slots[pos & PUBLISH_QUEUE_MASK];
+        size_t lap = pos & ~PUBLISH_QUEUE_MASK;
+        if (atomic_load_explicit(&slot->sequence, memory_order_acquire) != lap + 1) {
+            break;
+        }
+
+        // A multi-frame transfer that doesn't fit the pool would be enqueued partially, so wait instead
+        uint16_t frames = slot->payload_len <= 7 ? 1 : (uint16_t)((slot->payload_len + 2 + 6) / 7);
+        if (uavcanGetFreeTxFrames() < frames) {
+            break;
+        }
+
+        int16_t res = canardBroadcast(&node.g_canard,
+                                      slot->signature,
+                                      slot->id,
+                                      &slot->transfer_id,
+                                      slot->priority,
+                                      slot->payload,
+                                      slot->payload_len);
+        if (res < 0) {
+            atomic_fetch_add_explicit(&publish_queue.number_of_drops, 1, memory_order_relaxed);
+        }
+
+        atomic_store_explicit(&slot->sequence, lap + DRONECAN_PUBLISH_QUEUE_SIZE, memory_order_release);
+        publish_queue.dequeue_pos = pos + 1;
+    }
+#endif
 }
 
 static uint8_t uavcanProcessSending() {
@@ -300,7 +1062,7 @@ static uint8_t uavcanProcessSending() {
     uint8_t tx_attempt = 0;
     uint8_t tx_frames_counter = 0;
     while (txf) {
-        const int tx_res = platform.can.send(txf, CAN_DRIVER_FIRST);
+        const int tx_res = CAN_SEND(txf, CAN_DRIVER_FIRST);
         if (tx_res > 0) {
             canardPopTxQueue(&node.g_canard);
             txf = canardPeekTxQueue(&node.g_canard);
@@ -317,13 +1079,136 @@ static uint8_t uavcanProcessSending() {
     return tx_frames_counter;
 }
 
+static void uavcanDispatchFrame(const CanardCANFrame* frame, uint64_t timestamp_usec) {
+    if (!uavcanStreamHandleFrame(frame, timestamp_usec)) {
+        canardHandleRxFrame(&node.g_canard, frame, timestamp_usec);
+    }
+}
+
+#if DRONECAN_RX_STAGING_SIZE > 0
+static bool uavcanIsSheddable(const CanardCANFrame* frame) {
+    const uint32_t can_id = frame->id & CANARD_CAN_EXT_ID_MASK;
+    const bool is_service = (can_id >> 7U) & 0x1U;
+    if (is_service) {
+        return false;
+    }
+
+    const uint16_t data_type_id = (can_id >> 8U) & 0xFFFFU;
+    for (uint8_t idx = 0; idx < rx_staging.number_of_sheddable_types; idx++) {
+        if (rx_staging.sheddable_types[idx] == data_type_id) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+  * @return true if the staged frame a should be dispatched before b
+  */
+static bool uavcanIsStagedBefore(const StagedFrame_t* a, const StagedFrame_t* b) {
+    const uint32_t a_id = a->frame.id & CANARD_CAN_EXT_ID_MASK;
+    const uint32_t b_id = b->frame.id & CANARD_CAN_EXT_ID_MASK;
+    if (a_id != b_id) {
+        return a_id < b_id;
+    }
+    return (int32_t)(a->sequence - b->sequence) < 0;
+}
+
+/**
+  * @brief Put a frame into the staging buffer. If it is full, drop the least important frame:
+  * the lowest priority sheddable frame if there is any, otherwise the lowest priority frame.
+  */
+static void uavcanStageFrame(const CanardCANFrame* frame, uint64_t timestamp_usec) {
+    StagedFrame_t incoming = {*frame, timestamp_usec, rx_staging.next_sequence++};
+    if (rx_staging.stats.size < DRONECAN_RX_STAGING_SIZE) {
+        rx_staging.frames[rx_staging.stats.size] = incoming;
+        rx_staging.stats.size++;
+        if (rx_staging.stats.size > rx_staging.stats.peak_size) {
+            rx_staging.stats.peak_size = rx_staging.stats.size;
+        }
+        return;
+    }
+
+    const StagedFrame_t* victim = &incoming;
+    bool is_victim_sheddable = uavcanIsSheddable(frame);
+    for (uint8_t idx = 0; idx < DRONECAN_RX_STAGING_SIZE; idx++) {
+        const StagedFrame_t* candidate = &rx_staging.frames[idx];
+        bool is_sheddable = uavcanIsSheddable(&candidate->frame);
+        if (is_sheddable != is_victim_sheddable) {
+            if (is_sheddable) {
+                victim = candidate;
+                is_victim_sheddable = true;
+            }
+        } else if (uavcanIsStagedBefore(victim, candidate)) {
+            victim = candidate;
+        }
+    }
+
+    if (is_victim_sheddable) {
+        rx_staging.stats.shed_frames++;
+    } else {
+        rx_staging.stats.dropped_frames++;
+    }
+    if (victim != &incoming) {
+        rx_staging.frames[victim - rx_staging.frames] = incoming;
+    }
+}
+
+/**
+  * @brief Read from the driver only the frames the staging buffer can take without dropping a frame
+  * of a regular type: the free slots and the slots of the staged sheddable frames, which the new frames
+  * replace under overload. The rest waits in the driver for the next spin.
+  */
+static uint8_t uavcanGetRxStagingReadBudget() {
+    uint8_t budget = DRONECAN_RX_STAGING_SIZE - rx_staging.stats.size;
+    for (uint8_t idx = 0; idx < rx_staging.stats.size; idx++) {
+        if (uavcanIsSheddable(&rx_staging.frames[idx].frame)) {
+            budget++;
+        }
+    }
+    return budget;
+}
+
+/**
+  * @brief Drain the driver into the staging buffer, then dispatch the highest priority frames.
+  * The frames with the same CAN ID keep their order, so multi-frame transfers are not broken.
+  */
 static bool uavcanProcessReceiving(uint32_t crnt_time_ms) {
+    const uint64_t crnt_time_us = (uint64_t)crnt_time_ms * 1000U;
     CanardCANFrame rx_frame;
-    for (size_t idx = 0; idx < 10; idx++) {
-        int16_t res = platform.can.recv(&rx_frame, CAN_DRIVER_FIRST);
+    const uint8_t read_budget = uavcanGetRxStagingReadBudget();
+    for (uint8_t idx = 0; idx < read_budget; idx++) {
+        uint64_t timestamp_usec = crnt_time_us;
+        if (CAN_RECV(&rx_frame, &timestamp_usec, CAN_DRIVER_FIRST) <= 0) {
+            break;
+        }
+        uavcanStageFrame(&rx_frame, timestamp_usec);
+    }
+
+    for (size_t idx = 0; idx < RX_FRAMES_PER_SPIN && rx_staging.stats.size > 0; idx++) {
+        uint8_t best_idx = 0;
+        for (uint8_t staged_idx = 1; staged_idx < rx_staging.stats.size; staged_idx++) {
+            if (uavcanIsStagedBefore(&rx_staging.frames[staged_idx], &rx_staging.frames[best_idx])) {
+                best_idx = staged_idx;
+            }
+        }
+
+        StagedFrame_t staged = rx_staging.frames[best_idx];
+        rx_staging.stats.size--;
+        rx_staging.frames[best_idx] = rx_staging.frames[rx_staging.stats.size];
+        uavcanDispatchFrame(&staged.frame, staged.timestamp_usec);
+    }
+
+    return false;
+}
+#else
+static bool uavcanProcessReceiving(uint32_t crnt_time_ms) {
+    CanardCANFrame rx_frame;
+    for (size_t idx = 0; idx < RX_FRAMES_PER_SPIN; idx++) {
+        uint64_t timestamp_usec = crnt_time_ms * 1000UL;
+        int16_t res = CAN_RECV(&rx_frame, &timestamp_usec, CAN_DRIVER_FIRST);
         if (res) {
-            uint64_t crnt_time_us = crnt_time_ms * 1000UL;
-            canardHandleRxFrame(&node.g_canard, &rx_frame, crnt_time_us);
+            uavcanDispatchFrame(&rx_frame, timestamp_usec);
         } else {
             break;
         }
@@ -331,6 +1216,133 @@ static bool uavcanProcessReceiving(uint32_t crnt_time_ms) {
 
     return false;
 }
+#endif
+
+static uint16_t uavcanCrcAdd(uint16_t crc, const uint8_t* bytes, uint8_t len) {
+    while (len--) {
+        crc ^= (uint16_t)((uint16_t)(*bytes++) << 8U);
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000U) ? (uint16_t)((crc << 1U) ^ 0x1021U) : (uint16_t)(crc << 1U);
+        }
+    }
+    return crc;
+}
+
+static void uavcanStreamFinish(StreamSubscriber_t* sub, bool is_valid) {
+    sub->is_active = false;
+    sub->callbacks->on_end(&sub->transfer, is_valid);
+}
+
+/**
+  * @brief Pass the frame to the stream subscription of its data type, if there is one.
+  * The payload bytes are passed to the decoder immediately, the transfer is committed or discarded
+  * by the CRC check on the last frame.
+  * @return true if the frame has been consumed and should not be passed to libcanard
+  */
+static bool uavcanStreamHandleFrame(const CanardCANFrame* frame, uint64_t timestamp_usec) {
+    if (streams.number_of_subs == 0 || (frame->id & CANARD_CAN_FRAME_EFF) == 0 ||
+            (frame->id & (CANARD_CAN_FRAME_RTR | CANARD_CAN_FRAME_ERR)) != 0 || frame->data_len < 1) {
+        return false;
+    }
+
+    const uint32_t can_id = frame->id & CANARD_CAN_EXT_ID_MASK;
+    const uint8_t source_node_id = can_id & 0x7FU;
+    const bool is_service = (can_id >> 7U) & 0x1U;
+    uint16_t data_type_id;
+    CanardTransferType transfer_type;
+    if (!is_service) {
+        if (source_node_id == CANARD_BROADCAST_NODE_ID) {
+            return false;   // anonymous transfers are handled by libcanard
+        }
+        data_type_id = (can_id >> 8U) & 0xFFFFU;
+        transfer_type = CanardTransferTypeBroadcast;
+    } else {
+        const bool is_request = (can_id >> 15U) & 0x1U;
+        const uint8_t destination_node_id = (can_id >> 8U) & 0x7FU;
+        if (!is_request || destination_node_id != canardGetLocalNodeID(&node.g_canard)) {
+            return false;
+        }
+        data_type_id = (can_id >> 16U) & 0xFFU;
+        transfer_type = CanardTransferTypeRequest;
+    }
+
+    StreamSubscriber_t* sub = NULL;
+    for (uint8_t idx = 0; idx < streams.number_of_subs; idx++) {
+        if (streams.subscribers[idx].id == data_type_id) {
+            sub = &streams.subscribers[idx];
+            break;
+        }
+    }
+    if (sub == NULL) {
+        return false;
+    }
+
+    const uint8_t tail_byte = frame->data[frame->data_len - 1];
+    const bool is_start = (tail_byte >> 7U) & 0x1U;
+    const bool is_end = (tail_byte >> 6U) & 0x1U;
+    const uint8_t toggle = (tail_byte >> 5U) & 0x1U;
+    const uint8_t transfer_id = tail_byte & 0x1FU;
+    const uint8_t* payload = frame->data;
+    uint8_t payload_len = frame->data_len - 1;
+
+    if (is_start) {
+        if (sub->is_active) {
+            bool is_stale = (timestamp_usec - sub->transfer.timestamp_usec) > 2000000U;
+            if (sub->source_node_id != source_node_id && !is_stale) {
+                return true;    // another transfer is being received, this one is dropped
+            }
+            uavcanStreamFinish(sub, false);
+        }
+        if (toggle != 0 || (!is_end && payload_len < 2)) {
+            return true;
+        }
+
+        memset(&sub->transfer, 0x00, sizeof(CanardRxTransfer));
+        sub->transfer.timestamp_usec = timestamp_usec;
+        sub->transfer.data_type_id = data_type_id;
+        sub->transfer.transfer_type = (uint8_t)transfer_type;
+        sub->transfer.transfer_id = transfer_id;
+        sub->transfer.priority = (can_id >> 24U) & 0x1FU;
+        sub->transfer.source_node_id = source_node_id;
+        sub->transfer.sub_id = (uint8_t)(sub - streams.subscribers);
+        sub->source_node_id = source_node_id;
+        sub->transfer_id = transfer_id;
+        sub->next_toggle = 1;
+        sub->is_active = true;
+
+        if (!is_end) {
+            sub->expected_crc = (uint16_t)(payload[0] | (payload[1] << 8U));
+            payload += 2;
+            payload_len -= 2;
+            uint8_t signature[8];
+            for (uint8_t idx = 0; idx < 8; idx++) {
+                signature[idx] = (uint8_t)(sub->signature >> (8U * idx));
+            }
+            sub->crc = uavcanCrcAdd(0xFFFFU, signature, 8);
+        }
+
+        sub->callbacks->on_start(&sub->transfer);
+    } else if (!sub->is_active || sub->source_node_id != source_node_id || sub->transfer_id != transfer_id) {
+        return true;
+    } else if (toggle != sub->next_toggle) {
+        uavcanStreamFinish(sub, false);
+        return true;
+    } else {
+        sub->next_toggle ^= 1U;
+        sub->transfer.timestamp_usec = timestamp_usec;
+    }
+
+    sub->transfer.payload_len += payload_len;
+    if (!(is_start && is_end)) {
+        sub->crc = uavcanCrcAdd(sub->crc, payload, payload_len);
+    }
+    sub->callbacks->on_bytes(&sub->transfer, payload, payload_len);
+
+    if (is_end) {
+        uavcanStreamFinish(sub, (is_start && is_end) || sub->crc == sub->expected_crc);
+    }
+    return true;
+}
 
 static void uavcanSpinNodeStatus(uint32_t now_ms) {
     if (now_ms < node.node_status_last_send_time_ms + NODE_STATUS_SPIN_PERIOD_MS) {
@@ -388,7 +1400,7 @@ static void uavcanProtocolParamGetSetHandle(CanardRxTransfer* transfer) {
     // uint13 index
     uint16_t param_idx;
     if (param_name_length) {
-        param_idx = params.find(recv_name, param_name_length);
+        param_idx = PARAMS_FIND(recv_name, param_name_length);
     } else {
         param_idx = uavcanParamGetSetDecodeIndex(transfer);
     }
@@ -397,25 +1409,25 @@ static void uavcanProtocolParamGetSetHandle(CanardRxTransfer* transfer) {
     uint8_t resp[96] = "";
     uint16_t len;
 
-    const char* name = params.getName(param_idx);
-    if (params.isInteger(param_idx)) {
+    const char* name = PARAMS_GET_NAME(param_idx);
+    if (PARAMS_IS_INTEGER(param_idx)) {
         if (set_value_type_tag == PARAM_VALUE_INTEGER) {
-            params.integer.setValue(param_idx, val_int64);
+            PARAMS_SET_INTEGER_VALUE(param_idx, val_int64);
         }
-        IntegerParamValue_t val = params.integer.getValue(param_idx);
+        IntegerParamValue_t val = PARAMS_GET_INTEGER_VALUE(param_idx);
         len = uavcanParamGetSetMakeIntResponse(
             resp,
             val,
-            params.integer.getDef(param_idx),
-            params.integer.getMin(param_idx),
-            params.integer.getMax(param_idx),
+            PARAMS_GET_INTEGER_DEF(param_idx),
+            PARAMS_GET_INTEGER_MIN(param_idx),
+            PARAMS_GET_INTEGER_MAX(param_idx),
             name
         );
-    } else if (params.isString(param_idx)) {
+    } else if (PARAMS_IS_STRING(param_idx)) {
         if (set_value_type_tag == PARAM_VALUE_STRING) {
-            params.string.setValue(param_idx, str_len, val_string);
+            PARAMS_SET_STRING_VALUE(param_idx, str_len, val_string);
         }
-        const char* str_value = (const char*)params.string.getValue(param_idx);
+        const char* str_value = (const char*)PARAMS_GET_STRING_VALUE(param_idx);
         len = uavcanParamGetSetMakeStringResponse(resp, str_value, name);
     } else {
         len = uavcanParamGetSetMakeEmptyResponse(resp);
@@ -427,31 +1439,44 @@ static void uavcanProtocolParamGetSetHandle(CanardRxTransfer* transfer) {
 static void uavcanParamExecuteOpcodeHandle(CanardRxTransfer* transfer) {
     uint8_t opcode = uavcanProtocolParamExecuteOpcodeDecode(transfer);
 
+    // A save or reset that is still in progress keeps the flash busy, so the next one fails
+    const bool is_busy = pending_params_operation.is_pending;
+
     uint8_t opcode_buffer[7];
+    int8_t res = 0;
     int8_t ok;
     switch (opcode) {
         case 0:
-            ok = (params.save() == -1) ? 0 : 1;
+            res = is_busy ? -1 : PARAMS_SAVE();
+            ok = (res == -1) ? 0 : 1;
             break;
         case 1:
-            ok = (params.resetToDefault() < 0) ? 0 : 1;
+            res = is_busy ? -1 : PARAMS_RESET_TO_DEFAULT();
+            ok = (res < 0) ? 0 : 1;
             break;
         default:
             ok = -1;
             break;
     }
+
+    if (res == PARAMS_OPERATION_PENDING) {
+        pending_params_operation.token = uavcanDeferResponse(transfer);
+        pending_params_operation.is_pending = true;
+        return;
+    }
+
     uavcanProtocolParamExecuteOpcodeEncode(opcode_buffer, ok);
     uavcanRespond(transfer, UAVCAN_PROTOCOL_PARAM_EXECUTEOPCODE, opcode_buffer, 7);
 }
 
 static void uavcanProtocolRestartNodeHandle(__attribute__((unused)) CanardRxTransfer* transfer) {
-    uint8_t response_buffer = platform.requestRestart() ? 128 : 0;
+    uint8_t response_buffer = PLATFORM_REQUEST_RESTART() ? 128 : 0;
     uavcanRespond(transfer, UAVCAN_PROTOCOL_RESTART_NODE, &response_buffer, 1);
 }
 
 static void uavcanProtocolGetTransportStatHandle(CanardRxTransfer* transfer) {
     uint8_t transport_stats_buffer[UAVCAN_PROTOCOL_GET_TRANSPORT_STATS_MAX_SIZE];
-    node.iface_stats.transfer_errors = platform.can.getErrorCount();
+    node.iface_stats.transfer_errors = CAN_GET_ERROR_COUNT();
 
     uavcanEncodeTransportStats(transport_stats_buffer, &node.iface_stats);
     uavcanRespond(transfer, UAVCAN_PROTOCOL_GET_TRANSPORT_STATS, transport_stats_buffer, 72);
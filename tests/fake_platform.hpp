@@ -0,0 +1,206 @@
+/*
+ * Copyright (C) 2025 Dmitry Ponomarev <ponomarevda96@gmail.com>
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+/**
+ * @brief In-memory platform for the tests: the frames pushed to fake_rx are received by the next
+ * uavcanSpinOnce, the sent frames are appended to fake_tx, the time is set by the test.
+ * The params save and reset return fake_params_result.
+ */
+#ifndef LIBDCNODE_TESTS_FAKE_PLATFORM_HPP_
+#define LIBDCNODE_TESTS_FAKE_PLATFORM_HPP_
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <vector>
+#include "libdcnode/dronecan.h"
+
+#define TEST_CHECK(condition) do { \
+    if (!(condition)) { \
+        printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+        exit(1); \
+    } \
+} while (0)
+
+inline uint32_t fake_time_ms = 1000;
+inline std::deque<CanardCANFrame> fake_rx;
+inline std::vector<CanardCANFrame> fake_tx;
+inline int8_t fake_params_result = 0;
+
+inline void fakeStart(uint8_t node_id = 42) {
+    ParamsApi params_api{};
+    params_api.getName = [](ParamIndex_t) -> const char* { return "fake"; };
+    params_api.isInteger = [](ParamIndex_t) { return false; };
+    params_api.isString = [](ParamIndex_t) { return false; };
+    params_api.find = [](const uint8_t*, uint16_t) -> ParamIndex_t { return 0; };
+    params_api.save = []() -> int8_t { return fake_params_result; };
+    params_api.resetToDefault = []() -> int8_t { return fake_params_result; };
+
+    PlatformApi platform_api{};
+    platform_api.getTimeMs = []() { return fake_time_ms; };
+    platform_api.requestRestart = []() { return false; };
+    platform_api.readUniqueId = [](uint8_t out_uid[16]) { memset(out_uid, 0, 16); };
+    platform_api.can.init = [](uint32_t, uint8_t) -> int16_t { return 0; };
+    platform_api.can.recv = [](CanardCANFrame* frame, uint8_t) -> int16_t {
+        if (fake_rx.empty()) {
+            return 0;
+        }
+        *frame = fake_rx.front();
+        fake_rx.pop_front();
+        return 1;
+    };
+    platform_api.can.send = [](const CanardCANFrame* frame, uint8_t) -> int16_t {
+        fake_tx.push_back(*frame);
+        return 1;
+    };
+    platform_api.can.getRxOverflowCount = []() -> uint64_t { return 0; };
+    platform_api.can.getErrorCount = []() -> uint64_t { return 0; };
+
+    AppInfo app_info{};
+    app_info.node_id = node_id;
+    app_info.node_name = "test";
+    TEST_CHECK(uavcanInitApplication(params_api, platform_api, &app_info) >= 0);
+
+    // Send the first NodeStatus, so the memory pool is empty until the time goes forward
+    uavcanSpinOnce();
+    uavcanSpinOnce();
+    fake_tx.clear();
+}
+
+inline uint16_t fakeCrcAdd(uint16_t crc, uint8_t byte) {
+    crc ^= static_cast<uint16_t>(byte << 8);
+    for (uint8_t bit = 0; bit < 8; bit++) {
+        crc = (crc & 0x8000U) ? static_cast<uint16_t>((crc << 1) ^ 0x1021U) : static_cast<uint16_t>(crc << 1);
+    }
+    return crc;
+}
+
+/**
+ * @brief Split a transfer into CAN frames the same way a libcanard sender does
+ */
+inline std::vector<CanardCANFrame> fakeSplitTransfer(uint32_t can_id, uint64_t signature,
+                                                     const uint8_t* payload, uint16_t len, uint8_t transfer_id) {
+    std::vector<uint8_t> buffer;
+    if (len > 7) {
+        uint16_t crc = 0xFFFF;
+        for (uint8_t idx = 0; idx < 8; idx++) {
+            crc = fakeCrcAdd(crc, static_cast<uint8_t>(signature >> (8 * idx)));
+        }
+        for (uint16_t idx = 0; idx < len; idx++) {
+            crc = fakeCrcAdd(crc, payload[idx]);
+        }
+        buffer.push_back(static_cast<uint8_t>(crc & 0xFF));
+        buffer.push_back(static_cast<uint8_t>(crc >> 8));
+    }
+    buffer.insert(buffer.end(), payload, payload + len);
+
+    std::vector<CanardCANFrame> frames;
+    size_t offset = 0;
+    bool toggle = false;
+    do {
+        CanardCANFrame frame{};
+        frame.id = can_id | CANARD_CAN_FRAME_EFF;
+        size_t size = std::min<size_t>(7, buffer.size() - offset);
+        memcpy(frame.data, buffer.data() + offset, size);
+        uint8_t tail = (transfer_id & 31U) | (toggle ? 0x20U : 0U);
+        if (offset == 0) {
+            tail |= 0x80U;
+        }
+        if (offset + size == buffer.size()) {
+            tail |= 0x40U;
+        }
+        frame.data[size] = tail;
+        frame.data_len = static_cast<uint8_t>(size + 1);
+        frames.push_back(frame);
+        offset += size;
+        toggle = !toggle;
+    } while (offset < buffer.size());
+    return frames;
+}
+
+inline std::vector<CanardCANFrame> fakeMakeTransfer(uint64_t signature, uint16_t data_type_id, uint8_t src_node_id,
+                                                    const uint8_t* payload, uint16_t len, uint8_t transfer_id,
+                                                    uint8_t priority = CANARD_TRANSFER_PRIORITY_MEDIUM) {
+    uint32_t can_id = (static_cast<uint32_t>(priority) << 24) | (static_cast<uint32_t>(data_type_id) << 8) |
+                      src_node_id;
+    return fakeSplitTransfer(can_id, signature, payload, len, transfer_id);
+}
+
+inline std::vector<CanardCANFrame> fakeMakeServiceTransfer(uint64_t signature, uint8_t service_id, bool is_request,
+                                                           uint8_t src_node_id, uint8_t dst_node_id,
+                                                           const uint8_t* payload, uint16_t len, uint8_t transfer_id) {
+    uint32_t can_id = (static_cast<uint32_t>(CANARD_TRANSFER_PRIORITY_MEDIUM) << 24) |
+                      (static_cast<uint32_t>(service_id) << 16) | ((is_request ? 1U : 0U) << 15) |
+                      (static_cast<uint32_t>(dst_node_id) << 8) | (1U << 7) | src_node_id;
+    return fakeSplitTransfer(can_id, signature, payload, len, transfer_id);
+}
+
+inline bool fakeIsService(const CanardCANFrame& frame) {
+    return (frame.id >> 7) & 1U;
+}
+
+inline bool fakeIsRequest(const CanardCANFrame& frame) {
+    return fakeIsService(frame) && ((frame.id >> 15) & 1U);
+}
+
+inline uint16_t fakeGetDataTypeId(const CanardCANFrame& frame) {
+    return fakeIsService(frame) ? (frame.id >> 16) & 0xFFU : (frame.id >> 8) & 0xFFFFU;
+}
+
+inline uint8_t fakeGetTransferId(const CanardCANFrame& frame) {
+    return frame.data[frame.data_len - 1] & 31U;
+}
+
+/**
+ * @brief Join the payload of a sent transfer that starts at fake_tx[first_frame], without the CRC
+ */
+inline std::vector<uint8_t> fakeJoinPayload(size_t first_frame) {
+    std::vector<uint8_t> payload;
+    for (size_t idx = first_frame; idx < fake_tx.size(); idx++) {
+        const CanardCANFrame& frame = fake_tx[idx];
+        payload.insert(payload.end(), frame.data, frame.data + frame.data_len - 1);
+        if (frame.data[frame.data_len - 1] & 0x40U) {
+            break;
+        }
+    }
+    bool is_multi_frame = (fake_tx[first_frame].data[fake_tx[first_frame].data_len - 1] & 0x40U) == 0;
+    if (is_multi_frame) {
+        payload.erase(payload.begin(), payload.begin() + 2);
+    }
+    return payload;
+}
+
+/**
+ * @brief The indexes in fake_tx of the first frames of the sent broadcasts with the data type id
+ */
+inline std::vector<size_t> fakeFindBroadcasts(uint16_t data_type_id) {
+    std::vector<size_t> first_frames;
+    bool is_start = true;
+    for (size_t idx = 0; idx < fake_tx.size(); idx++) {
+        const CanardCANFrame& frame = fake_tx[idx];
+        if (is_start && !fakeIsService(frame) && fakeGetDataTypeId(frame) == data_type_id) {
+            first_frames.push_back(idx);
+        }
+        is_start = (frame.data[frame.data_len - 1] & 0x40U) != 0;
+    }
+    return first_frames;
+}
+
+/**
+ * @brief Spin until the frames are received and the transfers published meanwhile are sent
+ */
+inline void fakeReceive(const std::vector<CanardCANFrame>& frames) {
+    fake_rx.insert(fake_rx.end(), frames.begin(), frames.end());
+    while (!fake_rx.empty()) {
+        uavcanSpinOnce();
+    }
+    uavcanSpinOnce();
+}
+
+#endif  // LIBDCNODE_TESTS_FAKE_PLATFORM_HPP_
@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2025 Dmitry Ponomarev <ponomarevda96@gmail.com>
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+/**
+ * @brief DronecanAggregatingPublisher publishes the reduction of the samples pushed during the period,
+ * and nothing when no sample has been pushed.
+ */
+#include "fake_platform.hpp"
+#include "libdcnode/publisher.hpp"
+
+static constexpr float FREQUENCY = 10.0f;
+static constexpr uint32_t PERIOD_MS = 100;
+
+static std::vector<uint8_t> serialize(const StaticTemperature& msg) {
+    std::vector<uint8_t> buffer(UAVCAN_EQUIPMENT_AIR_DATA_STATIC_TEMPERATURE_MESSAGE_SIZE);
+    size_t size = buffer.size();
+    TEST_CHECK(dronecan_equipment_air_data_static_temperature_serialize(&msg, buffer.data(), &size) == 0);
+    return buffer;
+}
+
+/**
+ * @brief Push the samples at the beginning of a period and check the reduction published at its end
+ */
+static void checkReduction(DronecanAggregatingPublisher<StaticTemperature>& publisher, DronecanReducer reducer,
+                           const StaticTemperature& expected) {
+    publisher.reducer = reducer;
+    for (float temperature : {302.0f, 300.0f, 307.0f}) {
+        publisher.push({temperature, temperature - 300.0f});
+        publisher.spinOnce();
+    }
+    TEST_CHECK(publisher.getNumberOfSamples() == 3);
+    fake_time_ms += PERIOD_MS;
+
+    const size_t number_of_transfers = fakeFindBroadcasts(UAVCAN_EQUIPMENT_AIR_DATA_STATIC_TEMPERATURE_ID).size();
+    publisher.spinOnce();
+    uavcanSpinOnce();
+    auto transfers = fakeFindBroadcasts(UAVCAN_EQUIPMENT_AIR_DATA_STATIC_TEMPERATURE_ID);
+    TEST_CHECK(transfers.size() == number_of_transfers + 1);
+    TEST_CHECK(fakeJoinPayload(transfers.back()) == serialize(expected));
+    TEST_CHECK(publisher.getNumberOfSamples() == 0);
+}
+
+int main() {
+    fakeStart();
+    DronecanAggregatingPublisher<StaticTemperature> publisher(FREQUENCY);
+
+    // The first sample is published immediately and starts the period
+    publisher.push({1.0f, 1.0f});
+    publisher.spinOnce();
+    uavcanSpinOnce();
+    TEST_CHECK(fakeFindBroadcasts(UAVCAN_EQUIPMENT_AIR_DATA_STATIC_TEMPERATURE_ID).size() == 1);
+
+    checkReduction(publisher, DronecanReducer::MEAN, {303.0f, 3.0f});
+    checkReduction(publisher, DronecanReducer::MIN, {300.0f, 0.0f});
+    checkReduction(publisher, DronecanReducer::MAX, {307.0f, 7.0f});
+    checkReduction(publisher, DronecanReducer::LAST, {307.0f, 7.0f});
+
+    // Nothing has been pushed since the previous publication
+    fake_time_ms += PERIOD_MS;
+    const size_t number_of_transfers = fakeFindBroadcasts(UAVCAN_EQUIPMENT_AIR_DATA_STATIC_TEMPERATURE_ID).size();
+    publisher.spinOnce();
+    uavcanSpinOnce();
+    TEST_CHECK(fakeFindBroadcasts(UAVCAN_EQUIPMENT_AIR_DATA_STATIC_TEMPERATURE_ID).size() == number_of_transfers);
+    return 0;
+}
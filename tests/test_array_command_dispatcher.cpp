@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2025 Dmitry Ponomarev <ponomarevda96@gmail.com>
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+/**
+ * @brief DronecanArrayCommandDispatcher calls only the handler of each commanded actuator,
+ * with the command of this actuator, for single-frame and multi-frame ArrayCommand transfers.
+ */
+#include <cmath>
+#include "fake_platform.hpp"
+#include "libdcnode/subscriber.hpp"
+
+static constexpr uint8_t SRC_NODE_ID = 11;
+static constexpr uint8_t MAX_HANDLERS = 4;
+
+using Dispatcher = DronecanArrayCommandDispatcher<MAX_HANDLERS>;
+
+struct Actuator {
+    uint32_t number_of_commands{0};
+    Command_t last_command{};
+
+    void onCommand(const Command_t& command) {
+        number_of_commands++;
+        last_command = command;
+    }
+};
+
+static Actuator actuators[NUMBER_OF_ACTUATOR_ARRAY_COMMANDS];
+static uint8_t transfer_id = 0;
+
+static void sendCommands(uint8_t number_of_commands, float value) {
+    ArrayCommand_t msg{};
+    for (uint8_t idx = 0; idx < number_of_commands; idx++) {
+        msg.commads[idx] = {idx, 0, value + idx};
+    }
+    uint8_t buffer[UAVCAN_EQUIPMENT_ACTUATOR_ARRAY_COMMAND_MESSAGE_SIZE];
+    size_t size = sizeof(buffer);
+    TEST_CHECK(dronecan_equipment_actuator_arraycommand_serialize(&msg, buffer, &size, number_of_commands) == 0);
+    fakeReceive(fakeMakeTransfer(UAVCAN_EQUIPMENT_ACTUATOR_ARRAY_COMMAND_SIGNATURE,
+                                 UAVCAN_EQUIPMENT_ACTUATOR_ARRAY_COMMAND_ID, SRC_NODE_ID,
+                                 buffer, number_of_commands * UAVCAN_EQUIPMENT_ACTUATOR_COMMAND_MESSAGE_SIZE,
+                                 transfer_id++));
+}
+
+static bool isCommand(const Command_t& command, float expected_value) {
+    return std::fabs(command.command_value - expected_value) < 0.01f;
+}
+
+static Dispatcher::Handler handlerOf(uint8_t actuator_id) {
+    return Dispatcher::Handler::bind<&Actuator::onCommand>(&actuators[actuator_id]);
+}
+
+static void testDispatch(Dispatcher& dispatcher) {
+    sendCommands(1, 10.0f);
+    TEST_CHECK(actuators[0].number_of_commands == 1);
+    TEST_CHECK(actuators[0].last_command.actuator_id == 0);
+    TEST_CHECK(isCommand(actuators[0].last_command, 10.0f));
+
+    // A multi-frame transfer
+    sendCommands(8, 20.0f);
+    TEST_CHECK(actuators[0].number_of_commands == 2);
+    TEST_CHECK(actuators[3].number_of_commands == 1 && isCommand(actuators[3].last_command, 23.0f));
+    TEST_CHECK(actuators[7].number_of_commands == 1 && isCommand(actuators[7].last_command, 27.0f));
+    for (uint8_t idx : {1, 2, 4, 5, 6, 8}) {
+        TEST_CHECK(actuators[idx].number_of_commands == 0);
+    }
+    TEST_CHECK(dispatcher.getNumberOfHandlers() == 3);
+}
+
+static void testHandlersTable(Dispatcher& dispatcher) {
+    TEST_CHECK(dispatcher.addHandler(1, handlerOf(1)));
+    TEST_CHECK(!dispatcher.addHandler(2, handlerOf(2)));
+    TEST_CHECK(!dispatcher.addHandler(2, nullptr));
+
+    // Replace the handler of actuator 0 with the one of actuator 2, then remove actuator 3
+    TEST_CHECK(dispatcher.addHandler(0, handlerOf(2)));
+    dispatcher.removeHandler(3);
+    TEST_CHECK(dispatcher.getNumberOfHandlers() == 3);
+
+    sendCommands(8, 30.0f);
+    TEST_CHECK(actuators[0].number_of_commands == 2);
+    TEST_CHECK(actuators[2].number_of_commands == 1 && actuators[2].last_command.actuator_id == 0);
+    TEST_CHECK(actuators[1].number_of_commands == 1 && isCommand(actuators[1].last_command, 31.0f));
+    TEST_CHECK(actuators[3].number_of_commands == 1);
+    TEST_CHECK(actuators[7].number_of_commands == 2);
+}
+
+static void testUnsubscribe(Dispatcher& dispatcher) {
+    TEST_CHECK(dispatcher.unsubscribe() == 0);
+    sendCommands(8, 40.0f);
+    TEST_CHECK(actuators[1].number_of_commands == 1);
+    TEST_CHECK(actuators[7].number_of_commands == 2);
+}
+
+int main() {
+    fakeStart();
+    Dispatcher dispatcher;
+    TEST_CHECK(dispatcher.addHandler(0, handlerOf(0)));
+    TEST_CHECK(dispatcher.addHandler(3, handlerOf(3)));
+    TEST_CHECK(dispatcher.addHandler(7, handlerOf(7)));
+    TEST_CHECK(dispatcher.init() >= 0);
+
+    testDispatch(dispatcher);
+    testHandlersTable(dispatcher);
+    testUnsubscribe(dispatcher);
+    return 0;
+}
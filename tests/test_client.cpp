@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2025 Dmitry Ponomarev <ponomarevda96@gmail.com>
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+/**
+ * @brief Service client: a request gets exactly one callback, with the response or with NULL on timeout.
+ * The responses that match no outstanding request are dropped and never reach the service handlers.
+ */
+#include "fake_platform.hpp"
+#include "libdcnode/uavcan/protocol/get_node_info.h"
+
+static constexpr uint8_t NODE_ID = 42;
+static constexpr uint8_t SERVER_NODE_ID = 11;
+static constexpr uint16_t RESPONSE_SIZE = 40;
+static constexpr uint32_t TIMEOUT_MS = 100;
+
+struct Result {
+    uint32_t number_of_calls{0};
+    bool has_transfer{false};
+    uint8_t server_node_id{0};
+    uint16_t payload_len{0};
+};
+
+static void onResponse(CanardRxTransfer* transfer, uint8_t server_node_id, void* user_data) {
+    auto result = static_cast<Result*>(user_data);
+    result->number_of_calls++;
+    result->has_transfer = transfer != nullptr;
+    result->server_node_id = server_node_id;
+    result->payload_len = transfer != nullptr ? transfer->payload_len : 0;
+}
+
+/**
+ * @return the transfer id of the sent request
+ */
+static uint8_t requestNodeInfo(Result* result, uint8_t server_node_id = SERVER_NODE_ID) {
+    fake_tx.clear();
+    TEST_CHECK(uavcanRequest(UAVCAN_GET_NODE_INFO_DATA_TYPE_SIGNATURE, UAVCAN_GET_NODE_INFO_DATA_TYPE_ID,
+                             server_node_id, CANARD_TRANSFER_PRIORITY_MEDIUM, nullptr, 0,
+                             TIMEOUT_MS, onResponse, result) == 0);
+    uavcanSpinOnce();
+    TEST_CHECK(fake_tx.size() == 1);
+    TEST_CHECK(fakeIsRequest(fake_tx[0]) && fakeGetDataTypeId(fake_tx[0]) == UAVCAN_GET_NODE_INFO_DATA_TYPE_ID);
+    TEST_CHECK(((fake_tx[0].id >> 8) & 0x7FU) == server_node_id);
+    uint8_t transfer_id = fakeGetTransferId(fake_tx[0]);
+    fake_tx.clear();
+    return transfer_id;
+}
+
+static void respond(uint8_t transfer_id, uint8_t server_node_id = SERVER_NODE_ID) {
+    uint8_t payload[RESPONSE_SIZE] = {};
+    fakeReceive(fakeMakeServiceTransfer(UAVCAN_GET_NODE_INFO_DATA_TYPE_SIGNATURE, UAVCAN_GET_NODE_INFO_DATA_TYPE_ID,
+                                        false, server_node_id, NODE_ID, payload, RESPONSE_SIZE, transfer_id));
+}
+
+static void testResponse() {
+    Result result;
+    uint8_t transfer_id = requestNodeInfo(&result);
+    TEST_CHECK(uavcanGetNumberOfPendingRequests() == 1);
+
+    respond(transfer_id);
+    TEST_CHECK(result.number_of_calls == 1);
+    TEST_CHECK(result.has_transfer && result.server_node_id == SERVER_NODE_ID);
+    TEST_CHECK(result.payload_len == RESPONSE_SIZE);
+    TEST_CHECK(uavcanGetNumberOfPendingRequests() == 0);
+    TEST_CHECK(fake_tx.empty());
+
+    // A duplicate of the response
+    respond(transfer_id);
+    TEST_CHECK(result.number_of_calls == 1);
+    TEST_CHECK(fake_tx.empty());
+}
+
+static void testUnexpectedResponses() {
+    Result result;
+    uint8_t transfer_id = requestNodeInfo(&result);
+
+    respond((transfer_id + 1) & 31U);
+    respond(transfer_id, SERVER_NODE_ID + 1);
+    TEST_CHECK(result.number_of_calls == 0);
+    TEST_CHECK(uavcanGetNumberOfPendingRequests() == 1);
+    TEST_CHECK(fake_tx.empty());
+
+    respond(transfer_id);
+    TEST_CHECK(result.number_of_calls == 1 && result.has_transfer);
+}
+
+static void testLateResponse() {
+    Result result;
+    uint8_t transfer_id = requestNodeInfo(&result);
+
+    fake_time_ms += TIMEOUT_MS - 1;
+    uavcanSpinOnce();
+    TEST_CHECK(result.number_of_calls == 0);
+
+    fake_time_ms += 1;
+    uavcanSpinOnce();
+    TEST_CHECK(result.number_of_calls == 1 && !result.has_transfer);
+    TEST_CHECK(result.server_node_id == SERVER_NODE_ID);
+    TEST_CHECK(uavcanGetNumberOfPendingRequests() == 0);
+
+    // The late response reaches neither the callback nor the GetNodeInfo server of this node
+    fake_tx.clear();
+    respond(transfer_id);
+    TEST_CHECK(result.number_of_calls == 1);
+    for (const auto& frame : fake_tx) {
+        TEST_CHECK(!fakeIsService(frame));
+    }
+}
+
+static void testFullTable() {
+    Result results[DRONECAN_MAX_PENDING_REQUESTS + 1];
+    for (uint8_t idx = 0; idx < DRONECAN_MAX_PENDING_REQUESTS; idx++) {
+        requestNodeInfo(&results[idx], static_cast<uint8_t>(SERVER_NODE_ID + idx));
+    }
+    TEST_CHECK(uavcanRequest(UAVCAN_GET_NODE_INFO_DATA_TYPE_SIGNATURE, UAVCAN_GET_NODE_INFO_DATA_TYPE_ID,
+                             SERVER_NODE_ID, CANARD_TRANSFER_PRIORITY_MEDIUM, nullptr, 0,
+                             TIMEOUT_MS, onResponse, &results[DRONECAN_MAX_PENDING_REQUESTS]) ==
+               -CANARD_ERROR_OUT_OF_MEMORY);
+
+    fake_time_ms += TIMEOUT_MS;
+    uavcanSpinOnce();
+    for (uint8_t idx = 0; idx < DRONECAN_MAX_PENDING_REQUESTS; idx++) {
+        TEST_CHECK(results[idx].number_of_calls == 1 && !results[idx].has_transfer);
+    }
+    TEST_CHECK(results[DRONECAN_MAX_PENDING_REQUESTS].number_of_calls == 0);
+    TEST_CHECK(uavcanGetNumberOfPendingRequests() == 0);
+}
+
+static void testServerStillResponds() {
+    fake_tx.clear();
+    fakeReceive(fakeMakeServiceTransfer(UAVCAN_GET_NODE_INFO_DATA_TYPE_SIGNATURE, UAVCAN_GET_NODE_INFO_DATA_TYPE_ID,
+                                        true, SERVER_NODE_ID, NODE_ID, nullptr, 0, 7));
+    TEST_CHECK(!fake_tx.empty());
+    TEST_CHECK(fakeIsService(fake_tx[0]) && !fakeIsRequest(fake_tx[0]));
+    TEST_CHECK(fakeGetTransferId(fake_tx[0]) == 7);
+}
+
+int main() {
+    fakeStart(NODE_ID);
+    testResponse();
+    testUnexpectedResponses();
+    testLateResponse();
+    testFullTable();
+    testServerStillResponds();
+    return 0;
+}
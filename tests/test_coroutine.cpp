@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2025 Dmitry Ponomarev <ponomarevda96@gmail.com>
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+/**
+ * @brief DronecanScheduler resumes a task only when its event fires: an expired sleep, the next message
+ * of an awaitable subscriber or free space in the TX queue. A finished task frees its slot.
+ */
+#include "fake_platform.hpp"
+#include "libdcnode/coroutine.hpp"
+
+static constexpr uint8_t SRC_NODE_ID = 11;
+static constexpr uint64_t SIGNATURE = 0x1234567890ABCDEF;
+static constexpr uint16_t DATA_TYPE_ID = 20000;
+static constexpr uint32_t PERIOD_MS = 10;
+static constexpr uint8_t MAX_TASKS = 3;
+
+using Scheduler = DronecanScheduler<MAX_TASKS>;
+
+static Scheduler scheduler;
+static DronecanAwaitableSubscriber<RawCommand_t, Scheduler> subscriber;
+static uint32_t number_of_ticks = 0;
+static std::vector<int16_t> received;
+static uint8_t raw_command_transfer_id = 0;
+
+static DronecanTask ticker() {
+    while (true) {
+        co_await scheduler.sleep(PERIOD_MS);
+        number_of_ticks++;
+    }
+}
+
+static DronecanTask listener(uint8_t number_of_messages) {
+    for (uint8_t idx = 0; idx < number_of_messages; idx++) {
+        RawCommand_t msg = co_await subscriber.next();
+        received.push_back(msg.raw_cmd[0]);
+    }
+}
+
+static DronecanTask sender(uint8_t number_of_transfers, uint32_t* number_of_sent) {
+    uint8_t transfer_id = 0;
+    const uint8_t payload = 0;
+    for (uint8_t idx = 0; idx < number_of_transfers; idx++) {
+        co_await scheduler.txSpace(1);
+        if (uavcanPublish(SIGNATURE, DATA_TYPE_ID, &transfer_id, CANARD_TRANSFER_PRIORITY_LOW, &payload, 1) > 0) {
+            (*number_of_sent)++;
+        }
+    }
+}
+
+static std::vector<CanardCANFrame> makeRawCommand(int16_t value) {
+    RawCommand_t msg{};
+    msg.raw_cmd[0] = value;
+    uint8_t buffer[RAWCOMMAND_MAX_PAYLOAD_SIZE] = {};
+    size_t size = sizeof(buffer);
+    TEST_CHECK(dronecan_equipment_esc_raw_command_serialize(&msg, buffer, &size, 1) == 0);
+    return fakeMakeTransfer(UAVCAN_EQUIPMENT_ESC_RAWCOMMAND_SIGNATURE, UAVCAN_EQUIPMENT_ESC_RAWCOMMAND_ID,
+                            SRC_NODE_ID, buffer, 2, raw_command_transfer_id++);
+}
+
+static void spinWith(const std::vector<CanardCANFrame>& frames) {
+    fake_rx.insert(fake_rx.end(), frames.begin(), frames.end());
+    scheduler.spinOnce();
+}
+
+static void testSleep() {
+    TEST_CHECK(scheduler.spawn(ticker()) == 0);
+    scheduler.spinOnce();
+    TEST_CHECK(number_of_ticks == 0);
+
+    fake_time_ms += PERIOD_MS - 1;
+    scheduler.spinOnce();
+    TEST_CHECK(number_of_ticks == 0);
+
+    fake_time_ms += 1;
+    scheduler.spinOnce();
+    scheduler.spinOnce();
+    TEST_CHECK(number_of_ticks == 1);
+}
+
+static void testAwaitableSubscriber() {
+    // The message received before any task waits is dropped
+    spinWith(makeRawCommand(100));
+    TEST_CHECK(scheduler.spawn(listener(2)) == 0);
+    scheduler.spinOnce();
+    TEST_CHECK(received.empty());
+
+    spinWith(makeRawCommand(200));
+    TEST_CHECK((received == std::vector<int16_t>{200}));
+
+    // Several messages within one spin, the task gets the latest
+    auto frames = makeRawCommand(300);
+    auto latest = makeRawCommand(400);
+    frames.insert(frames.end(), latest.begin(), latest.end());
+    spinWith(frames);
+    TEST_CHECK((received == std::vector<int16_t>{200, 400}));
+
+    // The listener has finished and freed its slot
+    TEST_CHECK(scheduler.getNumberOfTasks() == 1);
+    spinWith(makeRawCommand(500));
+    TEST_CHECK(received.size() == 2);
+}
+
+static void testTxSpace() {
+    // The bus is busy, so the TX queue stays full while the node spins
+    const auto send = platform.can.send;
+    platform.can.send = [](const CanardCANFrame*, uint8_t) -> int16_t { return 0; };
+    uint8_t filler_transfer_id = 0;
+    const uint8_t filler = 0;
+    while (uavcanGetFreeTxFrames() > 0) {
+        TEST_CHECK(uavcanPublish(SIGNATURE, DATA_TYPE_ID + 1, &filler_transfer_id, CANARD_TRANSFER_PRIORITY_LOW,
+                                 &filler, 1) > 0);
+    }
+
+    // The task waits for the TX queue instead of losing the transfers
+    uint32_t number_of_sent = 0;
+    TEST_CHECK(scheduler.spawn(sender(3, &number_of_sent)) == 0);
+    scheduler.spinOnce();
+    scheduler.spinOnce();
+    TEST_CHECK(number_of_sent == 0);
+    TEST_CHECK(scheduler.getNumberOfTasks() == 2);
+
+    platform.can.send = send;
+    scheduler.spinOnce();
+    TEST_CHECK(number_of_sent == 3);
+    TEST_CHECK(scheduler.getNumberOfTasks() == 1);
+}
+
+static void testSpawnLimit() {
+    for (uint8_t idx = scheduler.getNumberOfTasks(); idx < MAX_TASKS; idx++) {
+        TEST_CHECK(scheduler.spawn(ticker()) == 0);
+    }
+    TEST_CHECK(scheduler.spawn(ticker()) < 0);
+    TEST_CHECK(scheduler.getNumberOfTasks() == MAX_TASKS);
+}
+
+int main() {
+    fakeStart();
+    TEST_CHECK(subscriber.init(&scheduler) >= 0);
+
+    testSleep();
+    testAwaitableSubscriber();
+    testTxSpace();
+    testSpawnLimit();
+    return 0;
+}
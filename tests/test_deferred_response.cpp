@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2025 Dmitry Ponomarev <ponomarevda96@gmail.com>
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+/**
+ * @brief Deferred responses: a service handler may answer after its transfer has been released,
+ * and ExecuteOpcode answers when a pending params save completes, rejecting the saves meanwhile.
+ */
+#include "fake_platform.hpp"
+#include "libdcnode/subscriber.hpp"
+#include "libdcnode/uavcan/protocol/param/execute_opcode.h"
+
+static constexpr uint8_t CLIENT_NODE_ID = 11;
+static constexpr uint8_t OTHER_CLIENT_NODE_ID = 12;
+static constexpr uint64_t SIGNATURE = 0x1234567890ABCDEF;
+static constexpr uint8_t SERVICE_ID = 200;
+static constexpr uint8_t OPCODE_SAVE = 0;
+
+static std::vector<UavcanResponseToken> tokens;
+
+static void onRequest(CanardRxTransfer* transfer) {
+    tokens.push_back(uavcanDeferResponse(transfer));
+}
+
+static void sendRequest(uint64_t signature, uint8_t service_id, uint8_t src_node_id, const uint8_t* payload,
+                        uint16_t len, uint8_t transfer_id) {
+    fakeReceive(fakeMakeServiceTransfer(signature, service_id, true, src_node_id, uavcanGetNodeId(),
+                                        payload, len, transfer_id));
+}
+
+/**
+ * @brief The first frames of the responses of the service sent so far
+ */
+static std::vector<size_t> findResponses(uint8_t service_id) {
+    std::vector<size_t> first_frames;
+    bool is_start = true;
+    for (size_t idx = 0; idx < fake_tx.size(); idx++) {
+        const CanardCANFrame& frame = fake_tx[idx];
+        if (fakeIsService(frame) && !fakeIsRequest(frame) && fakeGetDataTypeId(frame) == service_id && is_start) {
+            first_frames.push_back(idx);
+        }
+        is_start = (frame.data[frame.data_len - 1] & 0x40U) != 0;
+    }
+    return first_frames;
+}
+
+static bool isResponseTo(size_t first_frame, uint8_t dst_node_id, uint8_t transfer_id) {
+    const CanardCANFrame& frame = fake_tx[first_frame];
+    return ((frame.id >> 8) & 0x7FU) == dst_node_id && fakeGetTransferId(frame) == transfer_id &&
+           ((frame.id >> 24) & 0x1FU) == CANARD_TRANSFER_PRIORITY_MEDIUM;
+}
+
+static bool isExecuteOpcodeOk(size_t first_frame) {
+    auto payload = fakeJoinPayload(first_frame);
+    return payload.size() == 7 && (payload[6] & 0x80U) != 0;
+}
+
+static void testServiceHandler() {
+    fake_tx.clear();
+    const uint8_t request[3] = {1, 2, 3};
+    sendRequest(SIGNATURE, SERVICE_ID, CLIENT_NODE_ID, request, sizeof(request), 7);
+    sendRequest(SIGNATURE, SERVICE_ID, OTHER_CLIENT_NODE_ID, request, sizeof(request), 21);
+    TEST_CHECK(tokens.size() == 2);
+    TEST_CHECK(findResponses(SERVICE_ID).empty());
+
+    // The responses are given in any order, a long one is split into several frames
+    fake_time_ms += 300;
+    const uint8_t response[20] = {9, 8, 7};
+    TEST_CHECK(uavcanRespondDeferred(&tokens[1], SIGNATURE, SERVICE_ID, response, 1) == 1);
+    TEST_CHECK(uavcanRespondDeferred(&tokens[0], SIGNATURE, SERVICE_ID, response, sizeof(response)) > 1);
+    uavcanSpinOnce();
+
+    // The TX queue sends them in the order of CAN ID, so the response to the lower node id goes first
+    auto responses = findResponses(SERVICE_ID);
+    TEST_CHECK(responses.size() == 2);
+    TEST_CHECK(isResponseTo(responses[0], CLIENT_NODE_ID, 7));
+    TEST_CHECK(fakeJoinPayload(responses[0]) == std::vector<uint8_t>(response, response + sizeof(response)));
+    TEST_CHECK(isResponseTo(responses[1], OTHER_CLIENT_NODE_ID, 21));
+    TEST_CHECK(fakeJoinPayload(responses[1]) == std::vector<uint8_t>(response, response + 1));
+
+    TEST_CHECK(uavcanRespondDeferred(nullptr, SIGNATURE, SERVICE_ID, response, 1) < 0);
+    TEST_CHECK(uavcanRespondDeferred(&tokens[0], SIGNATURE, SERVICE_ID, nullptr, 0) < 0);
+}
+
+static void testPendingParamsSave() {
+    fake_tx.clear();
+    fake_params_result = PARAMS_OPERATION_PENDING;
+    const uint8_t opcode = OPCODE_SAVE;
+    sendRequest(UAVCAN_PROTOCOL_PARAM_EXECUTEOPCODE_SIGNATURE, UAVCAN_PROTOCOL_PARAM_EXECUTEOPCODE_ID,
+                CLIENT_NODE_ID, &opcode, 1, 3);
+    TEST_CHECK(findResponses(UAVCAN_PROTOCOL_PARAM_EXECUTEOPCODE_ID).empty());
+
+    // The flash is busy, so another save fails immediately
+    sendRequest(UAVCAN_PROTOCOL_PARAM_EXECUTEOPCODE_SIGNATURE, UAVCAN_PROTOCOL_PARAM_EXECUTEOPCODE_ID,
+                OTHER_CLIENT_NODE_ID, &opcode, 1, 4);
+    auto responses = findResponses(UAVCAN_PROTOCOL_PARAM_EXECUTEOPCODE_ID);
+    TEST_CHECK(responses.size() == 1);
+    TEST_CHECK(isResponseTo(responses[0], OTHER_CLIENT_NODE_ID, 4) && !isExecuteOpcodeOk(responses[0]));
+
+    uavcanParamsCompleteOperation(0);
+    uavcanSpinOnce();
+    responses = findResponses(UAVCAN_PROTOCOL_PARAM_EXECUTEOPCODE_ID);
+    TEST_CHECK(responses.size() == 2);
+    TEST_CHECK(isResponseTo(responses[1], CLIENT_NODE_ID, 3) && isExecuteOpcodeOk(responses[1]));
+
+    // Only the pending operation is answered
+    uavcanParamsCompleteOperation(0);
+    uavcanSpinOnce();
+    TEST_CHECK(findResponses(UAVCAN_PROTOCOL_PARAM_EXECUTEOPCODE_ID).size() == 2);
+
+    // A failed save is reported as well, after which the next save is accepted
+    sendRequest(UAVCAN_PROTOCOL_PARAM_EXECUTEOPCODE_SIGNATURE, UAVCAN_PROTOCOL_PARAM_EXECUTEOPCODE_ID,
+                CLIENT_NODE_ID, &opcode, 1, 5);
+    uavcanParamsCompleteOperation(-1);
+    uavcanSpinOnce();
+    responses = findResponses(UAVCAN_PROTOCOL_PARAM_EXECUTEOPCODE_ID);
+    TEST_CHECK(responses.size() == 3);
+    TEST_CHECK(isResponseTo(responses[2], CLIENT_NODE_ID, 5) && !isExecuteOpcodeOk(responses[2]));
+
+    fake_params_result = 0;
+    sendRequest(UAVCAN_PROTOCOL_PARAM_EXECUTEOPCODE_SIGNATURE, UAVCAN_PROTOCOL_PARAM_EXECUTEOPCODE_ID,
+                CLIENT_NODE_ID, &opcode, 1, 6);
+    responses = findResponses(UAVCAN_PROTOCOL_PARAM_EXECUTEOPCODE_ID);
+    TEST_CHECK(responses.size() == 4);
+    TEST_CHECK(isResponseTo(responses[3], CLIENT_NODE_ID, 6) && isExecuteOpcodeOk(responses[3]));
+}
+
+int main() {
+    fakeStart();
+    DronecanServiceHandler service;
+    TEST_CHECK(service.init(SIGNATURE, SERVICE_ID, onRequest) >= 0);
+
+    testServiceHandler();
+    testPendingParamsSave();
+    return 0;
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2025 Dmitry Ponomarev <ponomarevda96@gmail.com>
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+/**
+ * @brief Fast subscriptions: a single-frame transfer is delivered by uavcanHandleFrameFromIsr,
+ * a multi-frame one falls back to uavcanSpinOnce and reaches the same callback.
+ * A data type belongs either to a fast subscription or to the regular ones.
+ */
+#include "fake_platform.hpp"
+#include "libdcnode/uavcan/equipment/actuator/ArrayCommand.h"
+#include "libdcnode/uavcan/equipment/esc/RawCommand.h"
+
+static constexpr uint8_t SRC_NODE_ID = 11;
+static constexpr uint64_t TIMESTAMP_USEC = 123456;
+
+static uint32_t number_of_callbacks = 0;
+static std::vector<uint8_t> last_payload;
+static CanardRxTransfer last_transfer{};
+
+static void onArrayCommand(CanardRxTransfer* transfer) {
+    number_of_callbacks++;
+    last_transfer = *transfer;
+    last_payload.resize(transfer->payload_len);
+    for (uint16_t idx = 0; idx < transfer->payload_len; idx++) {
+        canardDecodeScalar(transfer, idx * 8U, 8, false, &last_payload[idx]);
+    }
+}
+
+static void onRawCommand(CanardRxTransfer*) {
+}
+
+static std::vector<CanardCANFrame> makeArrayCommand(uint8_t number_of_commands, uint8_t transfer_id,
+                                                    uint8_t src_node_id = SRC_NODE_ID) {
+    std::vector<uint8_t> payload(4U * number_of_commands);
+    for (size_t idx = 0; idx < payload.size(); idx++) {
+        payload[idx] = static_cast<uint8_t>(idx + transfer_id);
+    }
+    return fakeMakeTransfer(UAVCAN_EQUIPMENT_ACTUATOR_ARRAY_COMMAND_SIGNATURE,
+                            UAVCAN_EQUIPMENT_ACTUATOR_ARRAY_COMMAND_ID, src_node_id,
+                            payload.data(), static_cast<uint16_t>(payload.size()), transfer_id);
+}
+
+static void checkPayload(uint8_t number_of_commands, uint8_t transfer_id) {
+    TEST_CHECK(last_payload.size() == 4U * number_of_commands);
+    for (size_t idx = 0; idx < last_payload.size(); idx++) {
+        TEST_CHECK(last_payload[idx] == static_cast<uint8_t>(idx + transfer_id));
+    }
+    TEST_CHECK(last_transfer.source_node_id == SRC_NODE_ID && last_transfer.transfer_id == transfer_id);
+    TEST_CHECK(last_transfer.data_type_id == UAVCAN_EQUIPMENT_ACTUATOR_ARRAY_COMMAND_ID);
+}
+
+static void testSingleFrameFromIsr() {
+    number_of_callbacks = 0;
+    auto frames = makeArrayCommand(1, 3);
+    TEST_CHECK(frames.size() == 1);
+
+    TEST_CHECK(uavcanHandleFrameFromIsr(&frames[0], TIMESTAMP_USEC));
+    TEST_CHECK(number_of_callbacks == 1);
+    checkPayload(1, 3);
+    TEST_CHECK(last_transfer.timestamp_usec == TIMESTAMP_USEC);
+    TEST_CHECK(uavcanGetFastFallbackCount() == 0);
+
+    // An anonymous frame is left to libcanard, which drops it
+    auto anonymous = makeArrayCommand(1, 4, CANARD_BROADCAST_NODE_ID);
+    TEST_CHECK(!uavcanHandleFrameFromIsr(&anonymous[0], TIMESTAMP_USEC));
+    fakeReceive(anonymous);
+    TEST_CHECK(number_of_callbacks == 1);
+}
+
+static void testMultiFrameFallback() {
+    number_of_callbacks = 0;
+    auto frames = makeArrayCommand(4, 5);
+    TEST_CHECK(frames.size() > 1);
+
+    for (const auto& frame : frames) {
+        TEST_CHECK(!uavcanHandleFrameFromIsr(&frame, TIMESTAMP_USEC));
+    }
+    TEST_CHECK(number_of_callbacks == 0);
+    TEST_CHECK(uavcanGetFastFallbackCount() == 1);
+
+    fakeReceive(frames);
+    TEST_CHECK(number_of_callbacks == 1);
+    checkPayload(4, 5);
+}
+
+static void testOwnership() {
+    TEST_CHECK(uavcanSubscribe(UAVCAN_EQUIPMENT_ACTUATOR_ARRAY_COMMAND_SIGNATURE,
+                               UAVCAN_EQUIPMENT_ACTUATOR_ARRAY_COMMAND_ID, onArrayCommand) < 0);
+    TEST_CHECK(uavcanSubscribeFast(UAVCAN_EQUIPMENT_ACTUATOR_ARRAY_COMMAND_SIGNATURE,
+                                   UAVCAN_EQUIPMENT_ACTUATOR_ARRAY_COMMAND_ID, onArrayCommand) < 0);
+
+    int8_t sub_id = uavcanSubscribe(UAVCAN_EQUIPMENT_ESC_RAWCOMMAND_SIGNATURE, UAVCAN_EQUIPMENT_ESC_RAWCOMMAND_ID,
+                                    onRawCommand);
+    TEST_CHECK(sub_id >= 0);
+    TEST_CHECK(uavcanDisableSubscription(sub_id) == 0);
+    TEST_CHECK(uavcanSubscribeFast(UAVCAN_EQUIPMENT_ESC_RAWCOMMAND_SIGNATURE, UAVCAN_EQUIPMENT_ESC_RAWCOMMAND_ID,
+                                   onRawCommand) < 0);
+    TEST_CHECK(uavcanUnsubscribe(sub_id) == 0);
+    TEST_CHECK(uavcanSubscribeFast(UAVCAN_EQUIPMENT_ESC_RAWCOMMAND_SIGNATURE, UAVCAN_EQUIPMENT_ESC_RAWCOMMAND_ID,
+                                   onRawCommand) >= 0);
+}
+
+int main() {
+    fakeStart();
+    TEST_CHECK(uavcanSubscribeFast(UAVCAN_EQUIPMENT_ACTUATOR_ARRAY_COMMAND_SIGNATURE,
+                                   UAVCAN_EQUIPMENT_ACTUATOR_ARRAY_COMMAND_ID, onArrayCommand) >= 0);
+    testSingleFrameFromIsr();
+    testMultiFrameFallback();
+    testOwnership();
+    return 0;
+}
@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2025 Dmitry Ponomarev <ponomarevda96@gmail.com>
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+/**
+ * @brief DronecanIncrementalPublisher re-encodes only the dirty fields, so its payload matches a full
+ * serialization after set() and markDirty(), and increments the transfer id once per publication.
+ */
+#include "fake_platform.hpp"
+#include "libdcnode/publisher.hpp"
+
+static std::vector<uint8_t> serialize(const GnssFix2& msg) {
+    std::vector<uint8_t> buffer(UAVCAN_EQUIPMENT_GNSS_FIX2_MESSAGE_SIZE);
+    size_t size = buffer.size();
+    const int32_t number_of_bits = dronecan_equipment_gnss_fix2_serialize(&msg, buffer.data(), &size);
+    TEST_CHECK(number_of_bits > 0);
+    buffer.resize(static_cast<size_t>(number_of_bits + 7) / 8);
+    return buffer;
+}
+
+static void checkPublished(DronecanIncrementalPublisher<GnssFix2>& publisher, const GnssFix2& expected) {
+    TEST_CHECK(publisher.publish() > 0);
+    uavcanSpinOnce();
+    auto transfers = fakeFindBroadcasts(UAVCAN_EQUIPMENT_GNSS_FIX2_ID);
+    TEST_CHECK(!transfers.empty());
+    TEST_CHECK(fakeJoinPayload(transfers.back()) == serialize(expected));
+    TEST_CHECK(fakeGetTransferId(fake_tx[transfers.back()]) == transfers.size() - 1);
+}
+
+int main() {
+    fakeStart();
+    DronecanIncrementalPublisher<GnssFix2> publisher;
+
+    // The first publication encodes every field
+    checkPublished(publisher, GnssFix2{});
+
+    publisher.set(&GnssFix2::latitude_deg_1e8, int64_t{5512345678});
+    publisher.set(&GnssFix2::status, STATUS_3D_FIX);
+    publisher.set(&GnssFix2::sats_used, uint8_t{12});
+    checkPublished(publisher, publisher.get());
+
+    publisher.edit().covariance[2] = 1.5f;
+    publisher.markDirty(&GnssFix2::covariance);
+    checkPublished(publisher, publisher.get());
+
+    // A member modified without markDirty keeps its previously encoded value
+    GnssFix2 expected = publisher.get();
+    publisher.edit().height_msl_mm = 1000;
+    checkPublished(publisher, expected);
+
+    // The optional ECEF part changes the payload length
+    publisher.set(&GnssFix2::ecef_size, uint8_t{1});
+    publisher.edit().ecef.position_xyz_mm[0] = -123456789;
+    publisher.markDirty(&GnssFix2::ecef);
+    expected = publisher.get();
+    expected.height_msl_mm = 0;
+    checkPublished(publisher, expected);
+    TEST_CHECK(fakeJoinPayload(fakeFindBroadcasts(UAVCAN_EQUIPMENT_GNSS_FIX2_ID).back()).size() ==
+               UAVCAN_EQUIPMENT_GNSS_FIX2_MESSAGE_SIZE);
+    return 0;
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2025 Dmitry Ponomarev <ponomarevda96@gmail.com>
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+/**
+ * @brief DronecanMaskedRawCommandSubscriber decodes the masked channels to the same values as
+ * the full RawCommand deserializer, keeps the other channels untouched and reports the message size.
+ */
+#include "fake_platform.hpp"
+#include "libdcnode/subscriber.hpp"
+
+static constexpr uint8_t SRC_NODE_ID = 11;
+static constexpr int16_t UNTOUCHED = 0x1555;
+
+static uint32_t number_of_callbacks = 0;
+static RawCommand_t received{};
+static RawCommand_t reference{};
+static uint8_t transfer_id = 0;
+
+static void onRawCommand(const RawCommand_t& msg) {
+    number_of_callbacks++;
+    received = msg;
+}
+
+static void onReference(CanardRxTransfer* transfer) {
+    TEST_CHECK(dronecan_equipment_esc_raw_command_deserialize(transfer, &reference) >= 0);
+}
+
+static void sendRawCommand(uint8_t number_of_channels, int16_t offset) {
+    RawCommand_t msg{};
+    for (uint8_t idx = 0; idx < number_of_channels; idx++) {
+        // Cover the sign bit and both edges of the range
+        msg.raw_cmd[idx] = static_cast<int16_t>((idx % 2 ? -1 : 1) * (offset + 431 * idx));
+    }
+    msg.raw_cmd[0] = -UAVCAN_EQUIPMENT_ESC_RAWCOMMAND_MAX_VALUE;
+    msg.raw_cmd[number_of_channels - 1] = UAVCAN_EQUIPMENT_ESC_RAWCOMMAND_MAX_VALUE - 1;
+
+    uint8_t buffer[RAWCOMMAND_MAX_PAYLOAD_SIZE] = {};
+    size_t size = sizeof(buffer);
+    TEST_CHECK(dronecan_equipment_esc_raw_command_serialize(&msg, buffer, &size, number_of_channels) == 0);
+    const uint16_t payload_len = static_cast<uint16_t>((number_of_channels * RAWCOMMAND_BIT_LEN + 7) / 8);
+    fakeReceive(fakeMakeTransfer(UAVCAN_EQUIPMENT_ESC_RAWCOMMAND_SIGNATURE, UAVCAN_EQUIPMENT_ESC_RAWCOMMAND_ID,
+                                 SRC_NODE_ID, buffer, payload_len, transfer_id++));
+}
+
+static void testMaskedChannels(DronecanMaskedRawCommandSubscriber& subscriber, uint32_t mask) {
+    for (auto& value : subscriber.msg.raw_cmd) {
+        value = UNTOUCHED;
+    }
+
+    sendRawCommand(8, 100);
+    TEST_CHECK(number_of_callbacks == 1);
+    TEST_CHECK(received.size == 8 && reference.size == 8);
+    for (uint8_t idx = 0; idx < NUMBER_OF_RAW_CMD_CHANNELS; idx++) {
+        const bool is_decoded = (mask & (1UL << idx)) && idx < received.size;
+        TEST_CHECK(received.raw_cmd[idx] == (is_decoded ? reference.raw_cmd[idx] : UNTOUCHED));
+    }
+
+    // The previous values of the channels outside of the mask stay as they are
+    const int16_t channel_1 = received.raw_cmd[1];
+    sendRawCommand(8, 200);
+    TEST_CHECK(number_of_callbacks == 2);
+    TEST_CHECK(received.raw_cmd[1] == channel_1 && received.raw_cmd[1] != reference.raw_cmd[1]);
+    TEST_CHECK(received.raw_cmd[3] == reference.raw_cmd[3]);
+}
+
+static void testAllChannels(DronecanMaskedRawCommandSubscriber& subscriber) {
+    subscriber.channel_mask = (1UL << NUMBER_OF_RAW_CMD_CHANNELS) - 1U;
+
+    // A multi-frame transfer with a channel crossing every bit offset
+    for (uint8_t number_of_channels : {1, 5, 13, NUMBER_OF_RAW_CMD_CHANNELS}) {
+        sendRawCommand(number_of_channels, 1000);
+        TEST_CHECK(received.size == number_of_channels && reference.size == number_of_channels);
+        for (uint8_t idx = 0; idx < number_of_channels; idx++) {
+            TEST_CHECK(received.raw_cmd[idx] == reference.raw_cmd[idx]);
+        }
+    }
+}
+
+int main() {
+    fakeStart();
+    constexpr uint32_t MASK = (1UL << 0) | (1UL << 3) | (1UL << 7) | (1UL << 12);
+    DronecanMaskedRawCommandSubscriber subscriber;
+    TEST_CHECK(subscriber.init(onRawCommand, MASK) >= 0);
+
+    // A second regular subscriber of the same type decodes the whole message for comparison
+    TEST_CHECK(uavcanSubscribeEscRawCommand(onReference) >= 0);
+
+    testMaskedChannels(subscriber, MASK);
+    testAllChannels(subscriber);
+    return 0;
+}
@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2025 Dmitry Ponomarev <ponomarevda96@gmail.com>
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+/**
+ * @brief DronecanOnChangePublisher publishes when a field leaves its deadband, not faster than max_frequency,
+ * and at least with the heartbeat rate when nothing changes.
+ */
+#include "fake_platform.hpp"
+#include "libdcnode/publisher.hpp"
+
+static constexpr float HEARTBEAT_FREQUENCY = 1.0f;
+static constexpr float MAX_FREQUENCY = 100.0f;
+static constexpr uint32_t HEARTBEAT_PERIOD_MS = 1000;
+static constexpr uint32_t MIN_PERIOD_MS = 10;
+
+static std::vector<uint8_t> serialize(const Temperature_t& msg) {
+    std::vector<uint8_t> buffer(UAVCAN_EQUIPMENT_DEVICE_TEMPERATURE_MESSAGE_SIZE);
+    size_t size = buffer.size();
+    TEST_CHECK(dronecan_equipment_temperature_serialize(&msg, buffer.data(), &size) == 0);
+    return buffer;
+}
+
+/**
+ * @brief Advance the time, spin the publisher and check whether it has published its message
+ */
+static bool spinAfter(DronecanOnChangePublisher<Temperature_t>& publisher, uint32_t elapsed_ms) {
+    fake_time_ms += elapsed_ms;
+    const size_t number_of_transfers = fakeFindBroadcasts(UAVCAN_EQUIPMENT_DEVICE_TEMPERATURE_ID).size();
+    publisher.spinOnce();
+    uavcanSpinOnce();
+    auto transfers = fakeFindBroadcasts(UAVCAN_EQUIPMENT_DEVICE_TEMPERATURE_ID);
+    if (transfers.size() == number_of_transfers) {
+        return false;
+    }
+    TEST_CHECK(transfers.size() == number_of_transfers + 1);
+    TEST_CHECK(fakeJoinPayload(transfers.back()) == serialize(publisher.msg));
+    return true;
+}
+
+static void testDeadband(DronecanOnChangePublisher<Temperature_t>& publisher) {
+    publisher.msg = {1, 300.0f, ERROR_FLAG_OVERHEATING};
+    TEST_CHECK(spinAfter(publisher, 0));
+
+    // The deadband is relative to the last published value, so small steps add up
+    publisher.msg.temperature = 300.75f;
+    TEST_CHECK(!spinAfter(publisher, MIN_PERIOD_MS));
+    publisher.msg.temperature = 301.5f;
+    TEST_CHECK(spinAfter(publisher, MIN_PERIOD_MS));
+
+    publisher.msg.error_flags = ERROR_FLAG_OVERCOOLING;
+    TEST_CHECK(spinAfter(publisher, MIN_PERIOD_MS));
+}
+
+static void testRateLimit(DronecanOnChangePublisher<Temperature_t>& publisher) {
+    publisher.msg.temperature += 10.0f;
+    TEST_CHECK(spinAfter(publisher, MIN_PERIOD_MS));
+    publisher.msg.temperature += 10.0f;
+    TEST_CHECK(!spinAfter(publisher, MIN_PERIOD_MS - 1));
+    TEST_CHECK(spinAfter(publisher, 1));
+}
+
+static void testHeartbeat(DronecanOnChangePublisher<Temperature_t>& publisher) {
+    TEST_CHECK(!spinAfter(publisher, HEARTBEAT_PERIOD_MS - 1));
+    TEST_CHECK(spinAfter(publisher, 1));
+    TEST_CHECK(!spinAfter(publisher, HEARTBEAT_PERIOD_MS / 2));
+}
+
+int main() {
+    fakeStart();
+    const Temperature_t deadband = {0, 1.0f, ERROR_FLAG_OVERHEATING};
+    DronecanOnChangePublisher<Temperature_t> publisher(deadband, HEARTBEAT_FREQUENCY, MAX_FREQUENCY);
+    testDeadband(publisher);
+    testRateLimit(publisher);
+    testHeartbeat(publisher);
+    return 0;
+}
@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2025 Dmitry Ponomarev <ponomarevda96@gmail.com>
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+/**
+ * @brief uavcanPublishAsync: the transfers are sent by the next spin in the order of submission,
+ * a full queue rejects a transfer without taking its transfer id, and a transfer that doesn't fit
+ * the TX queue waits for the next spin instead of being dropped.
+ */
+#include "fake_platform.hpp"
+
+static constexpr uint64_t SIGNATURE = 0x1234567890ABCDEF;
+static constexpr uint16_t DATA_TYPE_ID = 20000;
+static constexpr uint16_t FILLER_ID = 20001;
+static constexpr uint16_t MULTI_FRAME_LEN = 20;
+
+static uint8_t transfer_id = 0;
+
+static int16_t publishAsync(uint8_t value, uint16_t len) {
+    std::vector<uint8_t> payload(len, value);
+    return uavcanPublishAsync(SIGNATURE, DATA_TYPE_ID, &transfer_id, CANARD_TRANSFER_PRIORITY_MEDIUM,
+                              payload.data(), len);
+}
+
+/**
+ * @brief The first frames of the transfers with DATA_TYPE_ID sent so far
+ */
+static std::vector<size_t> findSentTransfers() {
+    std::vector<size_t> first_frames;
+    bool is_start = true;
+    for (size_t idx = 0; idx < fake_tx.size(); idx++) {
+        const CanardCANFrame& frame = fake_tx[idx];
+        if (!fakeIsService(frame) && fakeGetDataTypeId(frame) == DATA_TYPE_ID && is_start) {
+            first_frames.push_back(idx);
+        }
+        is_start = (frame.data[frame.data_len - 1] & 0x40U) != 0;
+    }
+    return first_frames;
+}
+
+static void checkSentTransfer(size_t first_frame, uint8_t value, uint16_t len) {
+    auto payload = fakeJoinPayload(first_frame);
+    TEST_CHECK(payload == std::vector<uint8_t>(len, value));
+    TEST_CHECK(fakeGetTransferId(fake_tx[first_frame]) == value);
+}
+
+static void testPublishOnSpin() {
+    fake_tx.clear();
+    TEST_CHECK(publishAsync(0, 4) == 0);
+    TEST_CHECK(publishAsync(1, MULTI_FRAME_LEN) == 0);
+    TEST_CHECK(publishAsync(2, 0) == 0);
+    TEST_CHECK(transfer_id == 3);
+    TEST_CHECK(fake_tx.empty());
+
+    uavcanSpinOnce();
+    auto transfers = findSentTransfers();
+    TEST_CHECK(transfers.size() == 3);
+    checkSentTransfer(transfers[0], 0, 4);
+    checkSentTransfer(transfers[1], 1, MULTI_FRAME_LEN);
+    checkSentTransfer(transfers[2], 2, 0);
+}
+
+static void testQueueFull() {
+    fake_tx.clear();
+    for (uint8_t idx = 0; idx < DRONECAN_PUBLISH_QUEUE_SIZE; idx++) {
+        TEST_CHECK(publishAsync(transfer_id, 4) == 0);
+    }
+    const uint8_t next_transfer_id = transfer_id;
+    TEST_CHECK(publishAsync(transfer_id, 4) == -CANARD_ERROR_OUT_OF_MEMORY);
+    TEST_CHECK(transfer_id == next_transfer_id);
+    TEST_CHECK(uavcanGetPublishQueueDropCount() == 1);
+
+    uavcanSpinOnce();
+    TEST_CHECK(findSentTransfers().size() == DRONECAN_PUBLISH_QUEUE_SIZE);
+
+    // The slots are free again
+    TEST_CHECK(publishAsync(transfer_id, 4) == 0);
+    uavcanSpinOnce();
+    auto transfers = findSentTransfers();
+    TEST_CHECK(transfers.size() == DRONECAN_PUBLISH_QUEUE_SIZE + 1);
+    checkSentTransfer(transfers.back(), next_transfer_id, 4);
+}
+
+static void testInvalidArguments() {
+    TEST_CHECK(publishAsync(0, DRONECAN_PUBLISH_QUEUE_PAYLOAD_SIZE + 1) == -CANARD_ERROR_INVALID_ARGUMENT);
+    TEST_CHECK(uavcanPublishAsync(SIGNATURE, DATA_TYPE_ID, nullptr, CANARD_TRANSFER_PRIORITY_MEDIUM,
+                                  nullptr, 0) == -CANARD_ERROR_INVALID_ARGUMENT);
+    TEST_CHECK(uavcanGetPublishQueueDropCount() == 1);
+}
+
+static void testWaitForTxQueue() {
+    fake_tx.clear();
+    uint8_t filler_transfer_id = 0;
+    const uint8_t filler = 0;
+    while (uavcanGetFreeTxFrames() > 0) {
+        TEST_CHECK(uavcanPublish(SIGNATURE, FILLER_ID, &filler_transfer_id, CANARD_TRANSFER_PRIORITY_LOW,
+                                 &filler, 1) > 0);
+    }
+
+    const uint8_t expected_transfer_id = transfer_id;
+    TEST_CHECK(publishAsync(expected_transfer_id, MULTI_FRAME_LEN) == 0);
+    uavcanSpinOnce();
+    TEST_CHECK(findSentTransfers().empty());
+
+    uavcanSpinOnce();
+    auto transfers = findSentTransfers();
+    TEST_CHECK(transfers.size() == 1);
+    checkSentTransfer(transfers[0], expected_transfer_id, MULTI_FRAME_LEN);
+    TEST_CHECK(uavcanGetPublishQueueDropCount() == 1);
+}
+
+int main() {
+    static_assert(DRONECAN_PUBLISH_QUEUE_PAYLOAD_SIZE >= MULTI_FRAME_LEN, "the test needs a multi-frame slot");
+    fakeStart();
+    testPublishOnSpin();
+    testQueueFull();
+    testInvalidArguments();
+    testWaitForTxQueue();
+    return 0;
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2025 Dmitry Ponomarev <ponomarevda96@gmail.com>
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+/**
+ * @brief DronecanPublisherPool publishes one instance per period in the round-robin order,
+ * and the instances share one transfer id that is incremented once per publication.
+ */
+#include "fake_platform.hpp"
+#include "libdcnode/publisher.hpp"
+
+static constexpr uint8_t MAX_INSTANCES = 3;
+static constexpr float TOTAL_FREQUENCY = 100.0f;
+static constexpr uint32_t PERIOD_MS = 10;
+
+using Pool = DronecanPublisherPool<Temperature_t, MAX_INSTANCES>;
+
+static std::vector<uint8_t> serialize(const Temperature_t& msg) {
+    std::vector<uint8_t> buffer(UAVCAN_EQUIPMENT_DEVICE_TEMPERATURE_MESSAGE_SIZE);
+    size_t size = buffer.size();
+    TEST_CHECK(dronecan_equipment_temperature_serialize(&msg, buffer.data(), &size) == 0);
+    return buffer;
+}
+
+static void testInstances(Pool& pool) {
+    TEST_CHECK(pool.get(10) == nullptr);
+    for (uint16_t key = 10; key < 10 + MAX_INSTANCES; key++) {
+        Temperature_t* msg = pool.add(key);
+        TEST_CHECK(msg != nullptr);
+        msg->device_id = key;
+        msg->temperature = 300.0f + key;
+    }
+    TEST_CHECK(pool.add(10) == pool.get(10) && pool.get(10)->device_id == 10);
+    TEST_CHECK(pool.add(100) == nullptr);
+    TEST_CHECK(pool.getSize() == MAX_INSTANCES);
+}
+
+static void testRoundRobin(Pool& pool) {
+    fake_tx.clear();
+    const uint8_t number_of_periods = 2 * MAX_INSTANCES + 1;
+    for (uint8_t period = 0; period < number_of_periods; period++) {
+        pool.spinOnce();
+        pool.spinOnce();
+        uavcanSpinOnce();
+        fake_time_ms += PERIOD_MS;
+    }
+
+    auto transfers = fakeFindBroadcasts(UAVCAN_EQUIPMENT_DEVICE_TEMPERATURE_ID);
+    TEST_CHECK(transfers.size() == number_of_periods);
+    for (uint8_t idx = 0; idx < number_of_periods; idx++) {
+        const uint16_t key = 10 + idx % MAX_INSTANCES;
+        TEST_CHECK(fakeJoinPayload(transfers[idx]) == serialize(*pool.get(key)));
+        TEST_CHECK(fakeGetTransferId(fake_tx[transfers[idx]]) == idx);
+    }
+}
+
+int main() {
+    static_assert(static_cast<uint32_t>(1000.0f / TOTAL_FREQUENCY) == PERIOD_MS);
+    fakeStart();
+    Pool pool(TOTAL_FREQUENCY);
+    testInstances(pool);
+    testRoundRobin(pool);
+    return 0;
+}
@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2025 Dmitry Ponomarev <ponomarevda96@gmail.com>
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+/**
+ * @brief DronecanRawFilter on ArrayCommand transfers of every length, single-frame and multi-frame.
+ * Depending on the length, a multi-frame payload ends in the tail frame or in the middle blocks,
+ * and both layouts must be read correctly.
+ */
+#include "fake_platform.hpp"
+#include "libdcnode/subscriber.hpp"
+
+static constexpr uint8_t SRC_NODE_ID = 11;
+static constexpr uint8_t MAX_COMMANDS = 15;
+
+static uint8_t number_of_commands = 0;
+static uint32_t number_of_callbacks = 0;
+static uint32_t number_of_payloads_without_tail = 0;
+
+static void checkFilters(CanardRxTransfer* transfer) {
+    number_of_callbacks++;
+    if (transfer->payload_middle != nullptr && transfer->payload_tail == nullptr) {
+        number_of_payloads_without_tail++;
+    }
+
+    TEST_CHECK(transfer->payload_len == number_of_commands * UAVCAN_EQUIPMENT_ACTUATOR_COMMAND_MESSAGE_SIZE);
+    for (uint8_t actuator_id = 0; actuator_id < number_of_commands; actuator_id++) {
+        TEST_CHECK(DronecanRawFilter::arrayCommandActuatorId(actuator_id).match(transfer));
+    }
+    TEST_CHECK(!DronecanRawFilter::arrayCommandActuatorId(number_of_commands).match(transfer));
+
+    uint16_t last_byte = transfer->payload_len - 1;
+    TEST_CHECK(DronecanRawFilter::byteEquals(last_byte, static_cast<uint8_t>(0x80U | last_byte)).match(transfer));
+    TEST_CHECK(!DronecanRawFilter::byteEquals(last_byte, 0).match(transfer));
+}
+
+int main() {
+    fakeStart();
+    TEST_CHECK(uavcanSubscribe(UAVCAN_EQUIPMENT_ACTUATOR_ARRAY_COMMAND_SIGNATURE,
+                               UAVCAN_EQUIPMENT_ACTUATOR_ARRAY_COMMAND_ID,
+                               checkFilters) >= 0);
+
+    for (number_of_commands = 1; number_of_commands <= MAX_COMMANDS; number_of_commands++) {
+        // actuator_id, command_type and a float16 value, whose bytes are unique and never zero
+        uint8_t payload[MAX_COMMANDS * UAVCAN_EQUIPMENT_ACTUATOR_COMMAND_MESSAGE_SIZE];
+        uint16_t len = number_of_commands * UAVCAN_EQUIPMENT_ACTUATOR_COMMAND_MESSAGE_SIZE;
+        for (uint16_t idx = 0; idx < len; idx++) {
+            bool is_actuator_id = idx % UAVCAN_EQUIPMENT_ACTUATOR_COMMAND_MESSAGE_SIZE == 0;
+            payload[idx] = is_actuator_id ? static_cast<uint8_t>(idx / UAVCAN_EQUIPMENT_ACTUATOR_COMMAND_MESSAGE_SIZE) :
+                                            static_cast<uint8_t>(0x80U | idx);
+        }
+
+        fakeReceive(fakeMakeTransfer(UAVCAN_EQUIPMENT_ACTUATOR_ARRAY_COMMAND_SIGNATURE,
+                                     UAVCAN_EQUIPMENT_ACTUATOR_ARRAY_COMMAND_ID,
+                                     SRC_NODE_ID, payload, len, number_of_commands));
+        TEST_CHECK(number_of_callbacks == number_of_commands);
+    }
+
+    TEST_CHECK(number_of_payloads_without_tail > 0);
+    return 0;
+}
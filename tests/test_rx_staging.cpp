@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2025 Dmitry Ponomarev <ponomarevda96@gmail.com>
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+/**
+ * @brief RX staging buffer: the frames read by a spin are dispatched in the order of CAN ID priority,
+ * a spin reads only the frames the buffer can take, and under overload the new frames replace
+ * the staged frames of the sheddable types.
+ */
+#include "fake_platform.hpp"
+
+static constexpr uint8_t SRC_NODE_ID = 11;
+static constexpr uint64_t SIGNATURE = 0x1234567890ABCDEF;
+static constexpr uint16_t HIGH_ID = 20000;
+static constexpr uint16_t MEDIUM_ID = 20001;
+static constexpr uint16_t LOW_ID = 20002;
+static constexpr uint16_t SHEDDABLE_ID = 20003;
+static constexpr uint8_t FRAMES_PER_SPIN = 10;
+
+static std::vector<uint16_t> received;
+static uint8_t transfer_ids[4] = {};
+
+static void onTransfer(CanardRxTransfer* transfer) {
+    TEST_CHECK(transfer->payload_len == 1);
+    TEST_CHECK(transfer->payload_head[0] == transfer->transfer_id);
+    received.push_back(transfer->data_type_id);
+}
+
+static CanardCANFrame makeFrame(uint16_t data_type_id, uint8_t priority) {
+    uint8_t& transfer_id = transfer_ids[data_type_id - HIGH_ID];
+    uint8_t payload = transfer_id;
+    auto frames = fakeMakeTransfer(SIGNATURE, data_type_id, SRC_NODE_ID, &payload, 1, transfer_id, priority);
+    transfer_id = (transfer_id + 1) & 31U;
+    return frames[0];
+}
+
+static size_t count(uint16_t data_type_id) {
+    return static_cast<size_t>(std::count(received.begin(), received.end(), data_type_id));
+}
+
+static void testPriorityOrder() {
+    received.clear();
+    fake_rx.push_back(makeFrame(LOW_ID, CANARD_TRANSFER_PRIORITY_LOW));
+    fake_rx.push_back(makeFrame(MEDIUM_ID, CANARD_TRANSFER_PRIORITY_MEDIUM));
+    fake_rx.push_back(makeFrame(LOW_ID, CANARD_TRANSFER_PRIORITY_LOW));
+    fake_rx.push_back(makeFrame(HIGH_ID, CANARD_TRANSFER_PRIORITY_HIGH));
+    fake_rx.push_back(makeFrame(MEDIUM_ID, CANARD_TRANSFER_PRIORITY_MEDIUM));
+
+    uavcanSpinOnce();
+    TEST_CHECK(fake_rx.empty());
+    TEST_CHECK((received == std::vector<uint16_t>{HIGH_ID, MEDIUM_ID, MEDIUM_ID, LOW_ID, LOW_ID}));
+    TEST_CHECK(uavcanGetRxStagingStats()->size == 0);
+}
+
+static void testReadOnlyWhatFits() {
+    received.clear();
+    for (uint8_t idx = 0; idx < DRONECAN_RX_STAGING_SIZE + 4; idx++) {
+        fake_rx.push_back(makeFrame(MEDIUM_ID, CANARD_TRANSFER_PRIORITY_MEDIUM));
+    }
+
+    uavcanSpinOnce();
+    TEST_CHECK(received.size() == FRAMES_PER_SPIN);
+    TEST_CHECK(fake_rx.size() == 4);
+    TEST_CHECK(uavcanGetRxStagingStats()->size == DRONECAN_RX_STAGING_SIZE - FRAMES_PER_SPIN);
+
+    while (!fake_rx.empty() || uavcanGetRxStagingStats()->size > 0) {
+        uavcanSpinOnce();
+    }
+    TEST_CHECK(received.size() == DRONECAN_RX_STAGING_SIZE + 4);
+    TEST_CHECK(uavcanGetRxStagingStats()->dropped_frames == 0);
+    TEST_CHECK(uavcanGetRxStagingStats()->shed_frames == 0);
+}
+
+static void testShedding() {
+    received.clear();
+    const uint8_t number_of_sheddable = DRONECAN_RX_STAGING_SIZE - FRAMES_PER_SPIN;
+    for (uint8_t idx = 0; idx < FRAMES_PER_SPIN; idx++) {
+        fake_rx.push_back(makeFrame(MEDIUM_ID, CANARD_TRANSFER_PRIORITY_MEDIUM));
+    }
+    for (uint8_t idx = 0; idx < number_of_sheddable; idx++) {
+        fake_rx.push_back(makeFrame(SHEDDABLE_ID, CANARD_TRANSFER_PRIORITY_LOWEST));
+    }
+
+    // The sheddable frames have the lowest priority, so they stay in the buffer
+    uavcanSpinOnce();
+    TEST_CHECK(count(MEDIUM_ID) == FRAMES_PER_SPIN && count(SHEDDABLE_ID) == 0);
+    TEST_CHECK(uavcanGetRxStagingStats()->size == number_of_sheddable);
+
+    // The new frames take the free slots and then replace the sheddable frames
+    for (uint8_t idx = 0; idx < DRONECAN_RX_STAGING_SIZE + 2; idx++) {
+        fake_rx.push_back(makeFrame(HIGH_ID, CANARD_TRANSFER_PRIORITY_HIGH));
+    }
+    uavcanSpinOnce();
+    TEST_CHECK(fake_rx.size() == 2);
+    TEST_CHECK(uavcanGetRxStagingStats()->shed_frames == number_of_sheddable);
+
+    while (!fake_rx.empty() || uavcanGetRxStagingStats()->size > 0) {
+        uavcanSpinOnce();
+    }
+    TEST_CHECK(count(HIGH_ID) == DRONECAN_RX_STAGING_SIZE + 2);
+    TEST_CHECK(count(SHEDDABLE_ID) == 0);
+    TEST_CHECK(uavcanGetRxStagingStats()->dropped_frames == 0);
+    TEST_CHECK(uavcanGetRxStagingStats()->peak_size == DRONECAN_RX_STAGING_SIZE);
+}
+
+int main() {
+    static_assert(DRONECAN_RX_STAGING_SIZE > FRAMES_PER_SPIN, "the test needs the frames left after a spin");
+    fakeStart();
+    for (uint16_t id = HIGH_ID; id <= SHEDDABLE_ID; id++) {
+        TEST_CHECK(uavcanSubscribe(SIGNATURE, id, onTransfer) >= 0);
+    }
+    TEST_CHECK(uavcanAddSheddableType(SHEDDABLE_ID) == 0);
+
+    testPriorityOrder();
+    testReadOnlyWhatFits();
+    testShedding();
+    return 0;
+}
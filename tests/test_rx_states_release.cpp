@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2025 Dmitry Ponomarev <ponomarevda96@gmail.com>
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+/**
+ * @brief A subscription disabled or removed from its own callback of a multi-frame transfer.
+ * libcanard still uses the RX state of the transfer when the callback returns, so the state must stay
+ * allocated during the callback and be released later by the same uavcanSpinOnce.
+ * Outside of the callbacks the states are released immediately.
+ */
+#include "fake_platform.hpp"
+#include "libdcnode/uavcan/equipment/ahrs/Solution.h"
+
+static constexpr uint8_t SRC_NODE_ID = 11;
+static constexpr uint16_t PAYLOAD_SIZE = 40;
+
+static int8_t sub_id = -1;
+static uint32_t number_of_callbacks = 0;
+
+static std::vector<CanardCANFrame> makeSolution(uint8_t transfer_id) {
+    uint8_t payload[PAYLOAD_SIZE];
+    for (uint16_t idx = 0; idx < PAYLOAD_SIZE; idx++) {
+        payload[idx] = static_cast<uint8_t>(idx + transfer_id);
+    }
+    return fakeMakeTransfer(UAVCAN_EQUIPMENT_AHRS_SOLUTION_SIGNATURE, UAVCAN_EQUIPMENT_AHRS_SOLUTION_ID,
+                            SRC_NODE_ID, payload, PAYLOAD_SIZE, transfer_id);
+}
+
+static void checkPayload(CanardRxTransfer* transfer) {
+    TEST_CHECK(transfer->payload_len == PAYLOAD_SIZE);
+    for (uint16_t idx = 0; idx < PAYLOAD_SIZE; idx++) {
+        uint8_t byte = 0;
+        canardDecodeScalar(transfer, idx * 8U, 8, false, &byte);
+        TEST_CHECK(byte == static_cast<uint8_t>(idx + transfer->transfer_id));
+    }
+}
+
+static void disableItself(CanardRxTransfer* transfer) {
+    number_of_callbacks++;
+    const uint16_t free_frames = uavcanGetFreeTxFrames();
+    TEST_CHECK(uavcanDisableSubscription(sub_id) == 0);
+    TEST_CHECK(uavcanGetFreeTxFrames() == free_frames);
+    checkPayload(transfer);
+}
+
+static void unsubscribeItself(CanardRxTransfer* transfer) {
+    number_of_callbacks++;
+    const uint16_t free_frames = uavcanGetFreeTxFrames();
+    TEST_CHECK(uavcanUnsubscribe(sub_id) == 0);
+    TEST_CHECK(uavcanGetFreeTxFrames() == free_frames);
+    checkPayload(transfer);
+}
+
+static void testDisableFromCallback() {
+    number_of_callbacks = 0;
+    sub_id = uavcanSubscribe(UAVCAN_EQUIPMENT_AHRS_SOLUTION_SIGNATURE, UAVCAN_EQUIPMENT_AHRS_SOLUTION_ID,
+                             disableItself);
+    TEST_CHECK(sub_id >= 0);
+    const uint16_t free_frames = uavcanGetFreeTxFrames();
+
+    fakeReceive(makeSolution(0));
+    TEST_CHECK(number_of_callbacks == 1);
+    TEST_CHECK(!uavcanIsSubscriptionEnabled(sub_id));
+    TEST_CHECK(uavcanGetFreeTxFrames() == free_frames);
+
+    fakeReceive(makeSolution(1));
+    TEST_CHECK(number_of_callbacks == 1);
+    TEST_CHECK(uavcanGetFreeTxFrames() == free_frames);
+
+    TEST_CHECK(uavcanEnableSubscription(sub_id) == 0);
+    fakeReceive(makeSolution(2));
+    TEST_CHECK(number_of_callbacks == 2);
+    TEST_CHECK(uavcanGetFreeTxFrames() == free_frames);
+
+    TEST_CHECK(uavcanUnsubscribe(sub_id) == 0);
+}
+
+static void testUnsubscribeFromCallback() {
+    number_of_callbacks = 0;
+    sub_id = uavcanSubscribe(UAVCAN_EQUIPMENT_AHRS_SOLUTION_SIGNATURE, UAVCAN_EQUIPMENT_AHRS_SOLUTION_ID,
+                             unsubscribeItself);
+    TEST_CHECK(sub_id >= 0);
+    const uint16_t free_frames = uavcanGetFreeTxFrames();
+
+    fakeReceive(makeSolution(3));
+    TEST_CHECK(number_of_callbacks == 1);
+    TEST_CHECK(uavcanGetFreeTxFrames() == free_frames);
+
+    fakeReceive(makeSolution(4));
+    TEST_CHECK(number_of_callbacks == 1);
+    TEST_CHECK(uavcanGetFreeTxFrames() == free_frames);
+}
+
+static void testDisableOutsideSpin() {
+    number_of_callbacks = 0;
+    sub_id = uavcanSubscribe(UAVCAN_EQUIPMENT_AHRS_SOLUTION_SIGNATURE, UAVCAN_EQUIPMENT_AHRS_SOLUTION_ID,
+                             disableItself);
+    TEST_CHECK(sub_id >= 0);
+    const uint16_t free_frames = uavcanGetFreeTxFrames();
+
+    auto frames = makeSolution(5);
+    fakeReceive({frames[0], frames[1]});
+    TEST_CHECK(uavcanGetFreeTxFrames() < free_frames);
+
+    TEST_CHECK(uavcanDisableSubscription(sub_id) == 0);
+    TEST_CHECK(uavcanGetFreeTxFrames() == free_frames);
+    TEST_CHECK(uavcanUnsubscribe(sub_id) == 0);
+    TEST_CHECK(number_of_callbacks == 0);
+}
+
+int main() {
+    fakeStart();
+    testDisableFromCallback();
+    testUnsubscribeFromCallback();
+    testDisableOutsideSpin();
+    return 0;
+}
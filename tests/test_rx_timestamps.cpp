@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2025 Dmitry Ponomarev <ponomarevda96@gmail.com>
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+/**
+ * @brief A driver with recvTimestamped reports how long a frame has waited, so the transfer is timestamped
+ * with its arrival time instead of the time of the spin that received it.
+ */
+#include "fake_platform.hpp"
+
+static constexpr uint8_t SRC_NODE_ID = 11;
+static constexpr uint64_t SIGNATURE = 0x1234567890ABCDEF;
+static constexpr uint16_t DATA_TYPE_ID = 20000;
+static constexpr uint64_t AGE_USEC = 3500;
+
+static std::vector<uint64_t> timestamps;
+static std::deque<uint64_t> fake_rx_age_usec;
+
+static void onTransfer(CanardRxTransfer* transfer) {
+    timestamps.push_back(transfer->timestamp_usec);
+}
+
+static int16_t recvTimestamped(CanardCANFrame* frame, uint64_t* inout_timestamp_usec, uint8_t) {
+    if (fake_rx.empty()) {
+        return 0;
+    }
+    *frame = fake_rx.front();
+    fake_rx.pop_front();
+    *inout_timestamp_usec -= fake_rx_age_usec.front();
+    fake_rx_age_usec.pop_front();
+    return 1;
+}
+
+static std::vector<CanardCANFrame> makeTransfer(uint16_t len, uint8_t transfer_id) {
+    std::vector<uint8_t> payload(len, transfer_id);
+    return fakeMakeTransfer(SIGNATURE, DATA_TYPE_ID, SRC_NODE_ID, payload.data(), len, transfer_id);
+}
+
+static void testWithoutDriverTimestamps() {
+    timestamps.clear();
+    fakeReceive(makeTransfer(4, 0));
+    TEST_CHECK(timestamps.size() == 1);
+    TEST_CHECK(timestamps[0] == fake_time_ms * 1000ULL);
+}
+
+static void testDriverTimestamps() {
+    platform.can.recvTimestamped = recvTimestamped;
+
+    timestamps.clear();
+    auto frames = makeTransfer(4, 1);
+    fake_rx_age_usec.push_back(AGE_USEC);
+    fakeReceive(frames);
+    TEST_CHECK(timestamps.size() == 1);
+    TEST_CHECK(timestamps[0] == fake_time_ms * 1000ULL - AGE_USEC);
+
+    // libcanard timestamps a multi-frame transfer by its last frame
+    frames = makeTransfer(20, 2);
+    uint64_t last_frame_age_usec = 0;
+    for (size_t idx = 0; idx < frames.size(); idx++) {
+        last_frame_age_usec = AGE_USEC - idx * 100U;
+        fake_rx_age_usec.push_back(last_frame_age_usec);
+    }
+    fakeReceive(frames);
+    TEST_CHECK(timestamps.size() == 2);
+    TEST_CHECK(timestamps[1] == fake_time_ms * 1000ULL - last_frame_age_usec);
+
+    platform.can.recvTimestamped = nullptr;
+}
+
+int main() {
+    fakeStart();
+    TEST_CHECK(uavcanSubscribe(SIGNATURE, DATA_TYPE_ID, onTransfer) >= 0);
+    testWithoutDriverTimestamps();
+    testDriverTimestamps();
+    return 0;
+}
@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2025 Dmitry Ponomarev <ponomarevda96@gmail.com>
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+/**
+ * @brief DronecanSnapshotPublisher publishes the latest committed message, nothing before the first commit,
+ * and increments the transfer id once per publication.
+ */
+#include "fake_platform.hpp"
+#include "libdcnode/publisher.hpp"
+
+static Temperature_t makeTemperature(uint16_t device_id, float temperature) {
+    Temperature_t msg{};
+    msg.device_id = device_id;
+    msg.temperature = temperature;
+    msg.error_flags = ERROR_FLAG_OVERHEATING;
+    return msg;
+}
+
+static std::vector<uint8_t> serialize(const Temperature_t& msg) {
+    std::vector<uint8_t> buffer(UAVCAN_EQUIPMENT_DEVICE_TEMPERATURE_MESSAGE_SIZE);
+    size_t size = buffer.size();
+    TEST_CHECK(dronecan_equipment_temperature_serialize(&msg, buffer.data(), &size) == 0);
+    return buffer;
+}
+
+static void checkPublished(size_t number_of_transfers, const Temperature_t& msg) {
+    uavcanSpinOnce();
+    auto transfers = fakeFindBroadcasts(UAVCAN_EQUIPMENT_DEVICE_TEMPERATURE_ID);
+    TEST_CHECK(transfers.size() == number_of_transfers);
+    TEST_CHECK(fakeJoinPayload(transfers.back()) == serialize(msg));
+    TEST_CHECK(fakeGetTransferId(fake_tx[transfers.back()]) == number_of_transfers - 1);
+}
+
+int main() {
+    fakeStart();
+    DronecanSnapshotPublisher<Temperature_t> publisher;
+
+    TEST_CHECK(!publisher.publish());
+    uavcanSpinOnce();
+    TEST_CHECK(fakeFindBroadcasts(UAVCAN_EQUIPMENT_DEVICE_TEMPERATURE_ID).empty());
+
+    const auto first = makeTemperature(1, 300.0f);
+    publisher.commit(first);
+    TEST_CHECK(publisher.publish());
+    checkPublished(1, first);
+
+    // Only the latest of several commits is published, and it is published again until the next commit
+    const auto latest = makeTemperature(3, 320.0f);
+    publisher.commit(makeTemperature(2, 310.0f));
+    publisher.commit(latest);
+    TEST_CHECK(publisher.publish());
+    checkPublished(2, latest);
+    TEST_CHECK(publisher.publish());
+    checkPublished(3, latest);
+
+    Temperature_t snapshot{};
+    TEST_CHECK(publisher.snapshot(&snapshot));
+    TEST_CHECK(serialize(snapshot) == serialize(latest));
+    return 0;
+}
@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2025 Dmitry Ponomarev <ponomarevda96@gmail.com>
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+/**
+ * @brief DronecanStreamingSubscriber decodes Fix2 frame by frame to the same message that was serialized,
+ * discards a transfer with a broken CRC or toggle bit, and receives one source at a time.
+ */
+#include "fake_platform.hpp"
+#include "libdcnode/stream_subscriber.hpp"
+
+static constexpr uint8_t SRC_NODE_ID = 11;
+static constexpr uint8_t OTHER_NODE_ID = 12;
+
+static uint32_t number_of_callbacks = 0;
+static GnssFix2 received{};
+static uint8_t transfer_id = 0;
+
+static void onFix2(const GnssFix2& msg) {
+    number_of_callbacks++;
+    received = msg;
+}
+
+static GnssFix2 makeFix2(int64_t seed, bool has_ecef) {
+    GnssFix2 msg{};
+    msg.timestamp = 0x00AB'CDEF'0123'4567 + static_cast<uint64_t>(seed);
+    msg.gnss_timestamp = 0x0012'3456'789A'BCDE;
+    msg.gnss_time_standard = 2;
+    msg.num_leap_seconds = 18;
+    msg.longitude_deg_1e8 = -12345678901 - seed;
+    msg.latitude_deg_1e8 = 5512345678 + seed;
+    msg.height_ellipsoid_mm = -123456;
+    msg.height_msl_mm = 654321;
+    msg.sats_used = 17;
+    msg.status = STATUS_3D_FIX;
+    msg.mode = 2;
+    msg.sub_mode = 1;
+    msg.ecef_size = has_ecef ? 1 : 0;
+    msg.ecef.position_xyz_mm[0] = -34359738368 + seed;
+    msg.ecef.position_xyz_mm[1] = 123456789;
+    msg.ecef.position_xyz_mm[2] = 34359738367 - seed;
+    return msg;
+}
+
+static std::vector<CanardCANFrame> makeTransfer(const GnssFix2& msg, uint8_t src_node_id = SRC_NODE_ID) {
+    uint8_t buffer[UAVCAN_EQUIPMENT_GNSS_FIX2_MESSAGE_SIZE] = {};
+    size_t size = sizeof(buffer);
+    const int32_t number_of_bits = dronecan_equipment_gnss_fix2_serialize(&msg, buffer, &size);
+    TEST_CHECK(number_of_bits > 0);
+    return fakeMakeTransfer(UAVCAN_EQUIPMENT_GNSS_FIX2_SIGNATURE, UAVCAN_EQUIPMENT_GNSS_FIX2_ID, src_node_id,
+                            buffer, static_cast<uint16_t>((number_of_bits + 7) / 8), transfer_id++);
+}
+
+static bool isReceived(const GnssFix2& msg) {
+    bool is_equal = received.timestamp == msg.timestamp && received.gnss_timestamp == msg.gnss_timestamp &&
+        received.gnss_time_standard == msg.gnss_time_standard && received.num_leap_seconds == msg.num_leap_seconds &&
+        received.longitude_deg_1e8 == msg.longitude_deg_1e8 && received.latitude_deg_1e8 == msg.latitude_deg_1e8 &&
+        received.height_ellipsoid_mm == msg.height_ellipsoid_mm && received.height_msl_mm == msg.height_msl_mm &&
+        received.sats_used == msg.sats_used && received.status == msg.status && received.mode == msg.mode &&
+        received.sub_mode == msg.sub_mode && received.ecef_size == msg.ecef_size;
+    for (uint8_t idx = 0; msg.ecef_size == 1 && idx < 3; idx++) {
+        is_equal = is_equal && received.ecef.position_xyz_mm[idx] == msg.ecef.position_xyz_mm[idx];
+    }
+    return is_equal;
+}
+
+static void testDecode() {
+    number_of_callbacks = 0;
+    for (bool has_ecef : {false, true}) {
+        const auto msg = makeFix2(has_ecef, has_ecef);
+        fakeReceive(makeTransfer(msg));
+        TEST_CHECK(number_of_callbacks == (has_ecef ? 2U : 1U));
+        TEST_CHECK(isReceived(msg));
+    }
+}
+
+static void testBrokenTransfers(const DronecanStreamingSubscriber<GnssFix2>& subscriber) {
+    number_of_callbacks = 0;
+    const uint32_t discarded = subscriber.getNumberOfDiscarded();
+
+    // A corrupted payload byte is only detected by the CRC check on the last frame
+    auto frames = makeTransfer(makeFix2(3, true));
+    frames[frames.size() / 2].data[0] ^= 0x01U;
+    fakeReceive(frames);
+    TEST_CHECK(number_of_callbacks == 0);
+    TEST_CHECK(subscriber.getNumberOfDiscarded() == discarded + 1);
+
+    // A lost frame breaks the toggle bit sequence
+    frames = makeTransfer(makeFix2(4, true));
+    frames.erase(frames.begin() + 2);
+    fakeReceive(frames);
+    TEST_CHECK(number_of_callbacks == 0);
+    TEST_CHECK(subscriber.getNumberOfDiscarded() == discarded + 2);
+
+    // The next valid transfer is decoded from scratch
+    const auto msg = makeFix2(5, true);
+    fakeReceive(makeTransfer(msg));
+    TEST_CHECK(number_of_callbacks == 1 && isReceived(msg));
+}
+
+static void testInterleavedSources() {
+    number_of_callbacks = 0;
+    const auto msg = makeFix2(6, true);
+    const auto other_msg = makeFix2(7, false);
+    const auto frames = makeTransfer(msg);
+    const auto other_frames = makeTransfer(other_msg, OTHER_NODE_ID);
+
+    // The transfer that started first is received, the interleaved one is dropped as a whole
+    std::vector<CanardCANFrame> interleaved;
+    for (size_t idx = 0; idx < std::max(frames.size(), other_frames.size()); idx++) {
+        if (idx < frames.size()) {
+            interleaved.push_back(frames[idx]);
+        }
+        if (idx < other_frames.size()) {
+            interleaved.push_back(other_frames[idx]);
+        }
+    }
+    fakeReceive(interleaved);
+    TEST_CHECK(number_of_callbacks == 1 && isReceived(msg));
+
+    fakeReceive(other_frames);
+    TEST_CHECK(number_of_callbacks == 2 && isReceived(other_msg));
+}
+
+int main() {
+    fakeStart();
+    DronecanStreamingSubscriber<GnssFix2> subscriber;
+    TEST_CHECK(subscriber.init(onFix2) >= 0);
+
+    testDecode();
+    testBrokenTransfers(subscriber);
+    testInterleavedSources();
+    TEST_CHECK(subscriber.getNumberOfDiscarded() == 2);
+    return 0;
+}